@@ -83,7 +83,7 @@ void IntSet::resize(int new_capacity) {
     new_capacity = 1;
   capacity = new_capacity;
   int *newData = new int[new_capacity];
-  for (int i = 0; i < new_capacity; i++)
+  for (int i = 0; i < used; i++)
     newData[i] = data[i];
   delete[] data;
   data = newData;
@@ -0,0 +1,403 @@
+// FILE: IntSetBench.cpp
+//       A non-interactive benchmark program for the IntSet data type.
+//
+// DESCRIPTION:
+// Each IntSet operation (add, contains hit, contains miss, remove, unionWith,
+// intersect, subtract and ==) is timed across set sizes from 8 up to a
+// maximum (10M by default), for three key distributions:
+//   uniform     - keys drawn uniformly from the whole int range
+//   clustered   - keys packed in runs of 64 consecutive values around
+//                 random centers
+//   adversarial - keys on a 4096 stride fed in descending order (worst
+//                 case for front inserts into sorted storage, and a
+//                 power-of-two stride for hash bucketing)
+// The same workload is run against std::unordered_set, std::set and a
+// sorted std::vector for reference.
+//
+// Members are always even and "miss" keys always odd, so hit and miss
+// lookups are guaranteed without having to check the generated keys.
+//
+// Every per-key operation on IntSet (and add/remove on the sorted vector)
+// costs O(n), so those are timed over a smaller batch of keys that shrinks
+// as n grows; IntSet is skipped altogether above intset_max_n (16384 by
+// default) since building and combining sets there costs O(n^2).
+//
+// USAGE:
+//   a2bench [max_n [intset_max_n]]
+// Results are written to cout as a JSON array, one object per measurement:
+//   {"structure": ..., "op": ..., "dist": ..., "n": ..., "ops": ...,
+//    "ns_per_op": ...}
+// Progress is written to cerr.
+
+#include "IntSet.h"
+#include <algorithm> // provides sort, unique, lower_bound, set_union...
+#include <chrono>    // provides steady_clock
+#include <cstdlib>   // provides atol, EXIT_SUCCESS
+#include <iostream>  // provides cout, cerr
+#include <iterator>  // provides back_inserter
+#include <random>    // provides mt19937
+#include <set>
+#include <unordered_set>
+#include <vector>
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+// Sink for results that must not be optimized away.
+static volatile long sink = 0;
+
+// Minimum wall time spent on one measurement (repeats are added until met).
+const double MIN_TIME_NS = 2e7;
+
+// DISTRIBUTIONS
+enum Dist { UNIFORM, CLUSTERED, ADVERSARIAL };
+const char *DIST_NAME[] = {"uniform", "clustered", "adversarial"};
+
+vector<int> make_keys(Dist dist, size_t n, unsigned seed);
+// Pre:  n <= 2^29 (keys must fit in an int after doubling)
+// Post: n distinct values of the given distribution are returned, in
+//       the order they should be inserted. Every value v is returned as
+//       2*v (even); adding 1 to any of them produces a guaranteed miss.
+
+// TIMING
+bool first_result = true;
+
+void report(const char *structure, const char *op, Dist dist, size_t n,
+            size_t ops, double ns);
+// Pre:  ops > 0
+// Post: The measurement has been written to cout as one JSON object.
+
+size_t batch_size(size_t n, bool linear);
+// Post: The number of keys to time per-key operations over for a set of
+//       n elements is returned; linear is true if each such operation
+//       costs O(n).
+
+template <typename Adapter>
+void bench_structure(const char *name, Dist dist, size_t n,
+                     const vector<int> &a, const vector<int> &b,
+                     const vector<int> &probe);
+// Pre:  a and b hold n keys each (from make_keys), probe holds misses
+// Post: All operations have been timed on the structure wrapped by
+//       Adapter and reported.
+
+// ADAPTERS: a uniform interface over each structure being compared.
+// LINEAR_UPDATE/LINEAR_LOOKUP tell whether add/remove and contains cost
+// O(n) per key (and so have to be timed over a smaller batch of keys).
+struct IntSetAdapter {
+  typedef IntSet set_type;
+  static const bool LINEAR_UPDATE = true;
+  static const bool LINEAR_LOOKUP = true;
+  static void build(set_type &s, const vector<int> &keys) {
+    for (size_t i = 0; i < keys.size(); ++i)
+      s.add(keys[i]);
+  }
+  static bool add(set_type &s, int k) { return s.add(k); }
+  static bool contains(const set_type &s, int k) { return s.contains(k); }
+  static bool remove(set_type &s, int k) { return s.remove(k); }
+  static size_t unionWith(const set_type &x, const set_type &y) {
+    return x.unionWith(y).size();
+  }
+  static size_t intersect(const set_type &x, const set_type &y) {
+    return x.intersect(y).size();
+  }
+  static size_t subtract(const set_type &x, const set_type &y) {
+    return x.subtract(y).size();
+  }
+  static bool equal(const set_type &x, const set_type &y) { return x == y; }
+};
+
+struct UnorderedSetAdapter {
+  typedef unordered_set<int> set_type;
+  static const bool LINEAR_UPDATE = false;
+  static const bool LINEAR_LOOKUP = false;
+  static void build(set_type &s, const vector<int> &keys) {
+    s.insert(keys.begin(), keys.end());
+  }
+  static bool add(set_type &s, int k) { return s.insert(k).second; }
+  static bool contains(const set_type &s, int k) { return s.count(k) != 0; }
+  static bool remove(set_type &s, int k) { return s.erase(k) != 0; }
+  static size_t unionWith(const set_type &x, const set_type &y) {
+    set_type r(x);
+    r.insert(y.begin(), y.end());
+    return r.size();
+  }
+  static size_t intersect(const set_type &x, const set_type &y) {
+    set_type r;
+    for (set_type::const_iterator it = x.begin(); it != x.end(); ++it)
+      if (y.count(*it))
+        r.insert(*it);
+    return r.size();
+  }
+  static size_t subtract(const set_type &x, const set_type &y) {
+    set_type r;
+    for (set_type::const_iterator it = x.begin(); it != x.end(); ++it)
+      if (!y.count(*it))
+        r.insert(*it);
+    return r.size();
+  }
+  static bool equal(const set_type &x, const set_type &y) { return x == y; }
+};
+
+struct SetAdapter {
+  typedef set<int> set_type;
+  static const bool LINEAR_UPDATE = false;
+  static const bool LINEAR_LOOKUP = false;
+  static void build(set_type &s, const vector<int> &keys) {
+    s.insert(keys.begin(), keys.end());
+  }
+  static bool add(set_type &s, int k) { return s.insert(k).second; }
+  static bool contains(const set_type &s, int k) { return s.count(k) != 0; }
+  static bool remove(set_type &s, int k) { return s.erase(k) != 0; }
+  static size_t unionWith(const set_type &x, const set_type &y) {
+    set_type r;
+    set_union(x.begin(), x.end(), y.begin(), y.end(), inserter(r, r.end()));
+    return r.size();
+  }
+  static size_t intersect(const set_type &x, const set_type &y) {
+    set_type r;
+    set_intersection(x.begin(), x.end(), y.begin(), y.end(),
+                     inserter(r, r.end()));
+    return r.size();
+  }
+  static size_t subtract(const set_type &x, const set_type &y) {
+    set_type r;
+    set_difference(x.begin(), x.end(), y.begin(), y.end(),
+                   inserter(r, r.end()));
+    return r.size();
+  }
+  static bool equal(const set_type &x, const set_type &y) { return x == y; }
+};
+
+struct SortedVectorAdapter {
+  typedef vector<int> set_type;
+  static const bool LINEAR_UPDATE = true;
+  static const bool LINEAR_LOOKUP = false;
+  static void build(set_type &s, const vector<int> &keys) {
+    s = keys;
+    sort(s.begin(), s.end());
+    s.erase(unique(s.begin(), s.end()), s.end());
+  }
+  static bool add(set_type &s, int k) {
+    set_type::iterator it = lower_bound(s.begin(), s.end(), k);
+    if (it != s.end() && *it == k)
+      return false;
+    s.insert(it, k);
+    return true;
+  }
+  static bool contains(const set_type &s, int k) {
+    return binary_search(s.begin(), s.end(), k);
+  }
+  static bool remove(set_type &s, int k) {
+    set_type::iterator it = lower_bound(s.begin(), s.end(), k);
+    if (it == s.end() || *it != k)
+      return false;
+    s.erase(it);
+    return true;
+  }
+  static size_t unionWith(const set_type &x, const set_type &y) {
+    set_type r;
+    r.reserve(x.size() + y.size());
+    set_union(x.begin(), x.end(), y.begin(), y.end(), back_inserter(r));
+    return r.size();
+  }
+  static size_t intersect(const set_type &x, const set_type &y) {
+    set_type r;
+    set_intersection(x.begin(), x.end(), y.begin(), y.end(),
+                     back_inserter(r));
+    return r.size();
+  }
+  static size_t subtract(const set_type &x, const set_type &y) {
+    set_type r;
+    set_difference(x.begin(), x.end(), y.begin(), y.end(), back_inserter(r));
+    return r.size();
+  }
+  static bool equal(const set_type &x, const set_type &y) { return x == y; }
+};
+
+int main(int argc, char *argv[]) {
+  size_t max_n = 10000000;
+  size_t intset_max_n = 16384;
+  if (argc > 1)
+    max_n = size_t(atol(argv[1]));
+  if (argc > 2)
+    intset_max_n = size_t(atol(argv[2]));
+
+  cout << "[";
+  for (size_t n = 8; n <= max_n; n = (n * 8 > max_n && n < max_n) ? max_n
+                                                                   : n * 8) {
+    for (int d = UNIFORM; d <= ADVERSARIAL; ++d) {
+      Dist dist = Dist(d);
+      cerr << "n = " << n << ", " << DIST_NAME[dist] << endl;
+
+      // a and b share half their keys so that the union, intersection
+      // and difference are all non-trivial; the other half of b is made
+      // odd (disjoint from a) but keeps the distribution's shape.
+      vector<int> a = make_keys(dist, n, 1);
+      vector<int> b(a.begin() + n / 2, a.end());
+      vector<int> extra = make_keys(dist, n - b.size(), 2);
+      for (size_t i = 0; i < extra.size(); ++i)
+        b.push_back(extra[i] + 1);
+      vector<int> probe(a);
+      for (size_t i = 0; i < probe.size(); ++i)
+        ++probe[i];
+
+      if (n <= intset_max_n)
+        bench_structure<IntSetAdapter>("IntSet", dist, n, a, b, probe);
+      bench_structure<UnorderedSetAdapter>("std::unordered_set", dist, n, a,
+                                           b, probe);
+      bench_structure<SetAdapter>("std::set", dist, n, a, b, probe);
+      bench_structure<SortedVectorAdapter>("sorted std::vector", dist, n, a,
+                                           b, probe);
+    }
+    if (n == max_n)
+      break;
+  }
+  cout << "\n]" << endl;
+  cerr << "sink = " << sink << endl;
+
+  return EXIT_SUCCESS;
+}
+
+vector<int> make_keys(Dist dist, size_t n, unsigned seed) {
+  mt19937 gen(seed * 2654435761u + unsigned(dist));
+  vector<int> keys;
+  keys.reserve(n);
+
+  switch (dist) {
+  case UNIFORM: {
+    uniform_int_distribution<int> pick(-(1 << 29), (1 << 29) - 1);
+    unordered_set<int> seen;
+    while (keys.size() < n) {
+      int v = pick(gen);
+      if (seen.insert(v).second)
+        keys.push_back(v * 2);
+    }
+    break;
+  }
+  case CLUSTERED: {
+    // Runs of 64 consecutive values starting at distinct multiples of 4096
+    // (so runs never overlap), visited in random order.
+    const size_t RUN = 64;
+    size_t runs = (n + RUN - 1) / RUN;
+    vector<int> centers(runs);
+    for (size_t r = 0; r < runs; ++r)
+      centers[r] = int(r) * 4096;
+    shuffle(centers.begin(), centers.end(), gen);
+    for (size_t r = 0; r < runs && keys.size() < n; ++r)
+      for (size_t i = 0; i < RUN && keys.size() < n; ++i)
+        keys.push_back((centers[r] + int(i)) * 2 - (1 << 29));
+    break;
+  }
+  case ADVERSARIAL:
+    // Sweeps of 2^17 values on a 4096 stride (each sweep offset by one
+    // from the last), in descending order.
+    for (size_t i = n; i > 0; --i) {
+      int v = int((i - 1) % (1 << 17)) * 4096 + int((i - 1) >> 17);
+      keys.push_back((v - (1 << 29)) * 2);
+    }
+    break;
+  }
+  return keys;
+}
+
+void report(const char *structure, const char *op, Dist dist, size_t n,
+            size_t ops, double ns) {
+  cout << (first_result ? "\n" : ",\n") << "  {\"structure\": \"" << structure
+       << "\", \"op\": \"" << op << "\", \"dist\": \"" << DIST_NAME[dist]
+       << "\", \"n\": " << n << ", \"ops\": " << ops
+       << ", \"ns_per_op\": " << ns / ops << "}";
+  cout.flush();
+  first_result = false;
+}
+
+size_t batch_size(size_t n, bool linear) {
+  size_t q = linear ? (size_t(1) << 27) / n : n;
+  if (q > (size_t(1) << 16))
+    q = size_t(1) << 16;
+  if (q < 16)
+    q = 16;
+  return q < n ? q : n;
+}
+
+static double elapsed_ns(Clock::time_point since) {
+  return double(chrono::duration_cast<chrono::nanoseconds>(Clock::now() -
+                                                           since)
+                    .count());
+}
+
+template <typename Adapter>
+void bench_structure(const char *name, Dist dist, size_t n,
+                     const vector<int> &a, const vector<int> &b,
+                     const vector<int> &probe) {
+  typedef typename Adapter::set_type set_type;
+  set_type x, y, z;
+  Adapter::build(x, a);
+  Adapter::build(y, b);
+  Adapter::build(z, a); // equal to x but a separate object
+
+  size_t q = batch_size(n, Adapter::LINEAR_UPDATE);
+  size_t qlookup = batch_size(n, Adapter::LINEAR_LOOKUP);
+  double add_ns = 0, remove_ns = 0, hit_ns = 0, miss_ns = 0;
+  size_t add_ops = 0, remove_ops = 0, hit_ops = 0, miss_ops = 0;
+
+  // add/remove: insert q fresh (odd) keys, then remove them again, so x is
+  // back at n elements for every repeat.
+  while (add_ns + remove_ns < MIN_TIME_NS) {
+    Clock::time_point t = Clock::now();
+    for (size_t i = 0; i < q; ++i)
+      sink += Adapter::add(x, probe[i]);
+    add_ns += elapsed_ns(t);
+    add_ops += q;
+    t = Clock::now();
+    for (size_t i = 0; i < q; ++i)
+      sink += Adapter::remove(x, probe[i]);
+    remove_ns += elapsed_ns(t);
+    remove_ops += q;
+  }
+  while (hit_ns < MIN_TIME_NS) {
+    Clock::time_point t = Clock::now();
+    for (size_t i = 0; i < qlookup; ++i)
+      sink += Adapter::contains(x, a[(i * 7919) % n]);
+    hit_ns += elapsed_ns(t);
+    hit_ops += qlookup;
+  }
+  while (miss_ns < MIN_TIME_NS) {
+    Clock::time_point t = Clock::now();
+    for (size_t i = 0; i < qlookup; ++i)
+      sink += Adapter::contains(x, probe[(i * 7919) % n]);
+    miss_ns += elapsed_ns(t);
+    miss_ops += qlookup;
+  }
+  report(name, "add", dist, n, add_ops, add_ns);
+  report(name, "remove", dist, n, remove_ops, remove_ns);
+  report(name, "contains_hit", dist, n, hit_ops, hit_ns);
+  report(name, "contains_miss", dist, n, miss_ops, miss_ns);
+
+  // Whole-set operations: ns are per input element (2n per call). Equality
+  // is timed on two equal sets, the case where every element is compared.
+  const char *bulk_op[] = {"union", "intersect", "subtract", "equal"};
+  for (int op = 0; op < 4; ++op) {
+    double ns = 0;
+    size_t ops = 0;
+    while (ns < MIN_TIME_NS) {
+      Clock::time_point t = Clock::now();
+      switch (op) {
+      case 0:
+        sink += long(Adapter::unionWith(x, y));
+        break;
+      case 1:
+        sink += long(Adapter::intersect(x, y));
+        break;
+      case 2:
+        sink += long(Adapter::subtract(x, y));
+        break;
+      case 3:
+        sink += Adapter::equal(x, z);
+        break;
+      }
+      ns += elapsed_ns(t);
+      ops += 2 * n;
+    }
+    report(name, bulk_op[op], dist, n, ops, ns);
+  }
+}
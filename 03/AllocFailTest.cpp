@@ -0,0 +1,233 @@
+// FILE: AllocFailTest.cpp
+//       A non-interactive test program for what rope_sequence and
+//       unrolled_sequence do when memory runs out.
+//
+// DESCRIPTION:
+// operator new is replaced by one that can be told to fail (throw
+// bad_alloc) on its k-th call from now. split_at_cursor, splice, the
+// copy constructor and copy assignment of each engine are then run with
+// k = 1, 2, 3, ... until one gets through without a failure, on
+// sequences of up to 60000 items (three rope levels) with the cursor at
+// the front, inside, and past the end. After each failure, every
+// sequence involved must still hold exactly its old items and current
+// item, and must still work.
+//
+// USAGE:
+//   a3oom
+// Prints the number of failures injected for each engine and "passed",
+// or the first check that failed and "FAILED"; the exit status is
+// EXIT_SUCCESS only if it passed. Building it with
+// -fsanitize=address also catches leaks and freed nodes still in use.
+
+#include "RopeSequence.h"
+#include "UnrolledSequence.h"
+#include <cstdlib>  // provides free, malloc, exit, EXIT_SUCCESS,
+                    // EXIT_FAILURE
+#include <iostream> // provides cout
+#include <new>      // provides bad_alloc
+#include <vector>
+using namespace std;
+using namespace CS3358_SP2024;
+
+// The number of calls of operator new until one fails (0 for never).
+static size_t calls_until_failure = 0;
+
+void *operator new(size_t bytes) {
+  if (calls_until_failure > 0 && --calls_until_failure == 0)
+    throw bad_alloc();
+  void *p = malloc(bytes > 0 ? bytes : 1);
+  if (p == 0)
+    throw bad_alloc();
+  return p;
+}
+
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+// What a sequence should hold: its items, and the position of its
+// current item (items.size() if there is none).
+struct model {
+  vector<double> items;
+  size_t current;
+  model() : current(0) {}
+};
+
+static const char *engine_name = "";
+static const char *op_name = "";
+static size_t test_size = 0;
+static size_t test_cursor = 0;
+
+void fail(const char *what) {
+  cout << engine_name << " " << op_name << " (" << test_size
+       << " items, cursor at " << test_cursor << "): " << what << endl
+       << "FAILED" << endl;
+  exit(EXIT_FAILURE);
+}
+
+// Pre:  none
+// Post: s has been checked against m, and the program has stopped if
+//       they differ.
+template <class Seq> void check(const Seq &s, const model &m) {
+  size_t n = m.items.size();
+  if (s.size() != n)
+    fail("wrong size");
+  if (s.is_item() != (m.current < n))
+    fail("wrong is_item");
+  if (m.current < n && s.current() != m.items[m.current])
+    fail("wrong current item");
+  size_t i = 0;
+  for (typename Seq::const_iterator it = s.begin(); it != s.end(); ++it)
+    if (i >= n || *it != m.items[i++])
+      fail("wrong item");
+  if (i != n)
+    fail("too few items");
+  for (i = 0; i < n; i += 97)
+    if (s[i] != m.items[i])
+      fail("wrong item through operator[]");
+}
+
+// Pre:  none
+// Post: s has been checked against m, and then to still work: an item
+//       has been inserted and removed again.
+template <class Seq> void check_usable(Seq &s, const model &m) {
+  check(s, m);
+  s.insert(-1);
+  s.remove_current();
+  model after = m;
+  if (after.current == after.items.size())
+    after.current = 0; // insert with no current item inserts at the front
+  check(s, after);
+}
+
+// Pre:  cursor <= count
+// Post: s and m hold the items first, first+1, ..., first+count-1, and
+//       the one at position cursor (if any) is current.
+template <class Seq>
+void fill(Seq &s, model &m, size_t count, size_t cursor, double first) {
+  for (size_t i = 0; i < count; ++i) {
+    s.attach(first + i);
+    m.items.push_back(first + i);
+  }
+  s.start();
+  for (size_t i = 0; i < cursor; ++i)
+    s.advance();
+  m.current = cursor;
+}
+
+// Pre:  none
+// Post: split_at_cursor, splice, the copy constructor and copy
+//       assignment of Seq have been run on s (a sequence of n items with
+//       the cursor at cursor) with each allocation in turn failing, and
+//       the program has stopped if a failure left a sequence changed.
+//       The return value is the number of failures injected.
+template <class Seq> size_t test_failures(size_t n, size_t cursor) {
+  test_size = n;
+  test_cursor = cursor;
+  Seq source;
+  model ms;
+  fill(source, ms, n, cursor, 0);
+  Seq other_source;
+  model mo;
+  fill(other_source, mo, n / 2 + 3, 1, 1e6);
+  size_t failures = 0;
+
+  op_name = "split_at_cursor";
+  for (size_t k = 1;; ++k, ++failures) {
+    Seq s(source);
+    calls_until_failure = k;
+    try {
+      Seq tail = s.split_at_cursor();
+      calls_until_failure = 0;
+      model kept, split;
+      kept.items.assign(ms.items.begin(), ms.items.begin() + cursor);
+      kept.current = cursor;
+      split.items.assign(ms.items.begin() + cursor, ms.items.end());
+      check(s, kept);
+      check(tail, split);
+      break;
+    } catch (const bad_alloc &) {
+      calls_until_failure = 0;
+      check_usable(s, ms);
+    }
+  }
+
+  op_name = "splice";
+  for (size_t k = 1;; ++k, ++failures) {
+    Seq s(source), o(other_source);
+    calls_until_failure = k;
+    try {
+      s.splice(o);
+      calls_until_failure = 0;
+      model joined = ms;
+      joined.items.insert(joined.items.begin() + cursor, mo.items.begin(),
+                          mo.items.end());
+      joined.current = cursor + mo.items.size();
+      check(s, joined);
+      check(o, model());
+      break;
+    } catch (const bad_alloc &) {
+      calls_until_failure = 0;
+      check_usable(s, ms);
+      check_usable(o, mo);
+    }
+  }
+
+  op_name = "copy assignment";
+  for (size_t k = 1;; ++k, ++failures) {
+    Seq s;
+    model m;
+    fill(s, m, 300, 2, -1000);
+    calls_until_failure = k;
+    try {
+      s = source;
+      calls_until_failure = 0;
+      check(s, ms);
+      break;
+    } catch (const bad_alloc &) {
+      calls_until_failure = 0;
+      check_usable(s, m);
+    }
+  }
+
+  op_name = "copy constructor";
+  for (size_t k = 1;; ++k, ++failures) {
+    calls_until_failure = k;
+    try {
+      Seq s(source);
+      calls_until_failure = 0;
+      check(s, ms);
+      break;
+    } catch (const bad_alloc &) {
+      calls_until_failure = 0;
+    }
+  }
+  check(source, ms);
+  return failures;
+}
+
+// Pre:  none
+// Post: test_failures has been run for Seq on sequences of several
+//       sizes and cursors, and the number of failures injected printed.
+template <class Seq> void test_engine(const char *name) {
+  engine_name = name;
+  const size_t sizes[] = {0, 1, 200, 5000, 60000};
+  size_t failures = 0;
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+    size_t n = sizes[i];
+    failures += test_failures<Seq>(n, 0);
+    if (n > 0) {
+      failures += test_failures<Seq>(n, n / 3);
+      failures += test_failures<Seq>(n, n - 1);
+      failures += test_failures<Seq>(n, n);
+    }
+  }
+  cout << name << ": " << failures << " allocation failures injected"
+       << endl;
+}
+
+int main() {
+  test_engine<rope_sequence>("rope_sequence");
+  test_engine<unrolled_sequence>("unrolled_sequence");
+  cout << "passed" << endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,214 @@
+// FILE: CompressedSequence.cpp
+// CLASS IMPLEMENTED: compressed_sequence (see CompressedSequence.h for
+// documentation)
+// INVARIANT for the compressed_sequence class:
+//   1. The number of items is in the member variable used.
+//   2. The compressed items are a string of bits, stored in the vector
+//      bits 64 to a word, starting from the most significant bit of
+//      bits[0]. Block b (items b*BLOCK_SIZE on) starts at bit
+//      block_starts[b] of the string, with its first item's 64 bits
+//      (as a uint64_t). Each later item of the block follows as:
+//        0                 the same as the item before it;
+//        10 + bits         the XOR of it and the item before it, which
+//                          has the same leading and trailing zero bits
+//                          (or more) as the last XOR stored in full;
+//                          only its meaningful bits (between those
+//                          zeros) are stored;
+//        11 + 5 + 6 + bits any other XOR (not 0): 5 bits give its
+//                          number of leading zeros (up to 31), 6 bits
+//                          its number of meaningful bits (64 as 0), and
+//                          then come the meaningful bits.
+//   3. As for sequence, the index of the current item is in the member
+//      variable current_index, which is the same number as used if there
+//      is no current item.
+//   4. If there is a current item, value holds its bits, next_bit is the
+//      position in bits of the next item of its block (if any), and
+//      leading and meaningful describe the last XOR of the block stored
+//      in full (meaningful is 0 if there hasn't been one yet).
+
+#include "CompressedSequence.h"
+#include <cassert>
+#include <cstring>   // provides memcpy
+#include <stdexcept> // provides logic_error
+using namespace std;
+
+namespace {
+// Appends values to a string of bits stored as in invariant 2.
+class bit_writer {
+public:
+  bit_writer(vector<uint64_t> &words) : words(words), size(0) {}
+  uint64_t bit_count() const { return size; }
+
+  // Pre:  1 <= count <= 64
+  // Post: The low count bits of v have been appended, highest first.
+  void write(uint64_t v, unsigned count) {
+    if (count < 64)
+      v &= (uint64_t(1) << count) - 1;
+    unsigned used = size % 64;
+    if (used == 0)
+      words.push_back(0);
+    unsigned room = 64 - used;
+    if (count <= room) {
+      words.back() |= v << (room - count);
+    } else {
+      words.back() |= v >> (count - room);
+      words.push_back(v << (64 - (count - room)));
+    }
+    size += count;
+  }
+
+private:
+  vector<uint64_t> &words;
+  uint64_t size;
+};
+
+inline uint64_t to_bits(double x) {
+  uint64_t b;
+  memcpy(&b, &x, sizeof(b));
+  return b;
+}
+
+inline double from_bits(uint64_t b) {
+  double x;
+  memcpy(&x, &b, sizeof(x));
+  return x;
+}
+} // namespace
+
+namespace CS3358_SP2024 {
+// CONSTRUCTORS
+compressed_sequence::compressed_sequence()
+    : used(0), current_index(0), next_bit(0), value(0), leading(0),
+      meaningful(0) {}
+
+compressed_sequence::compressed_sequence(const sequence &source)
+    : used(source.size()), current_index(source.size()), next_bit(0),
+      value(0), leading(0), meaningful(0) {
+  bit_writer out(bits);
+  block_starts.reserve((used + BLOCK_SIZE - 1) / BLOCK_SIZE);
+
+  uint64_t previous = 0;
+  unsigned window_leading = 0, window_meaningful = 0;
+  for (size_type i = 0; i < used; ++i) {
+    uint64_t item = to_bits(source[i]);
+    if (i % BLOCK_SIZE == 0) {
+      block_starts.push_back(out.bit_count());
+      out.write(item, 64);
+      window_meaningful = 0;
+    } else {
+      uint64_t x = item ^ previous;
+      if (x == 0) {
+        out.write(0, 1);
+      } else {
+        unsigned lead = __builtin_clzll(x);
+        unsigned trail = __builtin_ctzll(x);
+        if (lead > 31)
+          lead = 31;
+        if (window_meaningful != 0 && lead >= window_leading &&
+            trail >= 64 - window_leading - window_meaningful) {
+          out.write(2, 2);
+          out.write(x >> (64 - window_leading - window_meaningful),
+                    window_meaningful);
+        } else {
+          unsigned count = 64 - lead - trail;
+          out.write(3, 2);
+          out.write(lead, 5);
+          out.write(count, 6); // 64 becomes 0
+          out.write(x >> trail, count);
+          window_leading = lead;
+          window_meaningful = count;
+        }
+      }
+    }
+    previous = item;
+  }
+  bits.shrink_to_fit();
+}
+
+// MODIFICATION MEMBER FUNCTIONS
+void compressed_sequence::start() {
+  current_index = 0;
+  if (used > 0)
+    start_block(0);
+}
+
+void compressed_sequence::advance() {
+  if (!is_item())
+    return;
+  ++current_index;
+  if (current_index == used)
+    return;
+  if (current_index % BLOCK_SIZE == 0)
+    start_block(current_index / BLOCK_SIZE);
+  else
+    decode_next();
+}
+
+void compressed_sequence::seek(size_type index) {
+  assert(index < used);
+  current_index = index - index % BLOCK_SIZE;
+  start_block(current_index / BLOCK_SIZE);
+  while (current_index < index) {
+    ++current_index;
+    decode_next();
+  }
+}
+
+// CONSTANT MEMBER FUNCTIONS
+compressed_sequence::size_type compressed_sequence::size() const {
+  return used;
+}
+
+bool compressed_sequence::is_item() const { return current_index < used; }
+
+compressed_sequence::value_type compressed_sequence::current() const {
+  if (!is_item()) {
+    throw std::logic_error("No current item in the sequence.");
+  }
+  return from_bits(value);
+}
+
+compressed_sequence::size_type compressed_sequence::compressed_bytes() const {
+  return (bits.size() + block_starts.size()) * sizeof(uint64_t);
+}
+
+// HELPER MEMBER FUNCTIONS
+// Pre:  block < the number of blocks
+// Post: The cursor is on the first item of the block (current_index is
+//       left to the caller).
+void compressed_sequence::start_block(size_type block) {
+  next_bit = block_starts[block];
+  value = read(64);
+  meaningful = 0;
+}
+
+// Pre:  The item after the one in value is in the same block, and
+//       next_bit is where it starts.
+// Post: value holds that item, and next_bit (and the XOR window) have
+//       moved past it.
+void compressed_sequence::decode_next() {
+  if (read(1) == 0)
+    return;
+  if (read(1) != 0) {
+    leading = read(5);
+    meaningful = read(6);
+    if (meaningful == 0)
+      meaningful = 64;
+  }
+  value ^= read(meaningful) << (64 - leading - meaningful);
+}
+
+// Pre:  1 <= count <= 64, and there are that many bits from next_bit on.
+// Post: The return value is the count bits from next_bit on (the first
+//       of them as its most significant bit), and next_bit has moved
+//       past them.
+uint64_t compressed_sequence::read(unsigned count) {
+  size_type word = next_bit / 64;
+  unsigned offset = next_bit % 64;
+  uint64_t result = (bits[word] << offset) >> (64 - count);
+  if (count > 64 - offset)
+    result |= bits[word + 1] >> (128 - offset - count);
+  next_bit += count;
+  return result;
+}
+} // namespace CS3358_SP2024
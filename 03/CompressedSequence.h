@@ -0,0 +1,117 @@
+// FILE: CompressedSequence.h
+// CLASS PROVIDED: compressed_sequence (part of the namespace
+// CS3358_SP2024)
+//
+// A compressed_sequence is a read-only copy of a sequence (see
+// Sequence.h) stored compressed, for keeping long runs of slowly
+// changing values (such as sensor readings) in a fraction of the memory.
+// Its items can be read in order with the usual cursor functions.
+//
+// The items are compressed as in Facebook's Gorilla time-series
+// database: each item is XORed with the one before it, and only the bits
+// that differ are stored. An item equal to the one before it takes 1
+// bit, and one that differs from it in the same bit positions as the
+// last change takes 2 bits plus those bits; any other takes 13 bits plus
+// the bits between its first and last differing bit. So values that
+// change slowly or not at all (or that repeat a few digits of precision)
+// take a few bits each rather than 64, whereas random values may take a
+// little more than 64. The items are split into blocks of BLOCK_SIZE
+// items, each compressed on its own (starting with its first item in
+// full), so the cursor can jump to any block and decompress just that
+// block, an item at a time, as it advances.
+//
+// TYPEDEFS and MEMBER CONSTANTS for the compressed_sequence class:
+//   value_type, size_type
+//    As for sequence (value_type must be double).
+//
+//   static const size_type BLOCK_SIZE = _____
+//    compressed_sequence::BLOCK_SIZE is the number of items in each
+//    block (except perhaps the last).
+//
+// CONSTRUCTORS for the compressed_sequence class:
+//   compressed_sequence()
+//    Pre:  none
+//    Post: The compressed_sequence is empty.
+//
+//   explicit compressed_sequence(const sequence& source)
+//    Pre:  none
+//    Post: The compressed_sequence holds the items of source, in the
+//      same order (each with exactly the same bits, so NaNs and -0.0
+//      are kept as they are). There is no current item. source is
+//      unchanged.
+//
+// MODIFICATION MEMBER FUNCTIONS for the compressed_sequence class:
+//   void start()
+//   void advance()
+//    As for sequence. advance decompresses the next item, which takes
+//    O(1) time.
+//
+//   void seek(size_type index)
+//    Pre:  index < size()
+//    Post: The item at position index (counting from 0 at the front) is
+//      now the current item.
+//    Note: Decompresses the items of its block up to it, so takes
+//      O(BLOCK_SIZE) time.
+//
+// CONSTANT MEMBER FUNCTIONS for the compressed_sequence class:
+//   size_type size() const
+//   bool is_item() const
+//   value_type current() const
+//    As for sequence (current throws std::logic_error if there is no
+//    current item).
+//
+//   size_type compressed_bytes() const
+//    Pre:  none
+//    Post: The return value is the number of bytes used for the
+//      compressed items (to compare with size() * sizeof(value_type)).
+//
+// VALUE SEMANTICS for the compressed_sequence class:
+//   Assignments and the copy constructor may be used with
+//   compressed_sequence objects (the copy gets the same current item).
+
+#ifndef COMPRESSED_SEQUENCE_H
+#define COMPRESSED_SEQUENCE_H
+#include <cstdint>  // provides uint64_t
+#include <vector>
+#include "Sequence.h"
+
+namespace CS3358_SP2024
+{
+   class compressed_sequence
+   {
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef sequence::value_type value_type;
+      typedef sequence::size_type size_type;
+      static const size_type BLOCK_SIZE = 512;
+      // CONSTRUCTORS
+      compressed_sequence();
+      explicit compressed_sequence(const sequence& source);
+      // MODIFICATION MEMBER FUNCTIONS
+      void start();
+      void advance();
+      void seek(size_type index);
+      // CONSTANT MEMBER FUNCTIONS
+      size_type size() const;
+      bool is_item() const;
+      value_type current() const;
+      size_type compressed_bytes() const;
+   private:
+      std::vector<std::uint64_t> bits;
+      std::vector<std::uint64_t> block_starts;
+      size_type used;
+      // The cursor: the current item and what's needed to decompress the
+      // next one (see CompressedSequence.cpp).
+      size_type current_index;
+      std::uint64_t next_bit;
+      std::uint64_t value;
+      unsigned leading;
+      unsigned meaningful;
+      // HELPER MEMBER FUNCTIONS
+      void start_block(size_type block);
+      void decode_next();
+      std::uint64_t read(unsigned count);
+   };
+}
+
+#endif
@@ -0,0 +1,163 @@
+// FILE: ConcurrentSequence.cpp
+// CLASS IMPLEMENTED: concurrent_sequence (see ConcurrentSequence.h for
+// documentation)
+// INVARIANT for the concurrent_sequence class:
+//   1. writer is the writer's copy, in copy-on-write mode; it is only
+//      ever touched by the writer thread.
+//   2. latest points to the latest published version: a heap-allocated
+//      sequence (sharing storage with writer, or with an older version
+//      of it) that is never changed, and is only read by snapshot,
+//      which copies it. It is owned by the concurrent_sequence.
+//   3. hazards holds one pointer per call to snapshot that is copying a
+//      version (the reader "pins" that version in its slot), and 0 in
+//      every other slot. A reader only counts its pin once it has seen
+//      latest still pointing to the version after storing it.
+//   4. retired holds the versions that have been replaced as latest but
+//      were pinned when the writer last looked, so can't be deleted yet.
+//      Each publish deletes every retired version that is in no slot
+//      (see reclaim), which is safe: a reader that loaded it either has
+//      finished copying it (and its copy shares the storage, which is
+//      counted, so it outlives the version) or will find latest changed
+//      and drop it. As each one left is pinned by a different slot,
+//      there are never more than HAZARD_SLOTS of them.
+//
+// This is read-copy-update (RCU) with hazard pointers: readers wait only
+// if all slots are taken, since a version is never changed after it is
+// published, and the writer never waits for readers, since it defers
+// deleting old versions instead. A version is kept only as long as its
+// own readers need it, however many other snapshots overlap.
+
+#include "ConcurrentSequence.h"
+#include <algorithm>  // provides binary_search, sort
+#include <functional> // provides hash
+#include <thread>     // provides this_thread
+using namespace std;
+
+namespace CS3358_SP2024 {
+// CONSTRUCTOR and DESTRUCTOR
+concurrent_sequence::concurrent_sequence(size_type initial_capacity)
+    : writer(initial_capacity), latest(0) {
+  for (size_type i = 0; i < HAZARD_SLOTS; ++i)
+    hazards[i].store(0);
+  writer.copy_on_write(true);
+  latest.store(new sequence(writer));
+}
+
+concurrent_sequence::~concurrent_sequence() {
+  delete latest.load();
+  for (size_type i = 0; i < retired.size(); ++i)
+    delete retired[i];
+}
+
+// WRITER FUNCTIONS
+void concurrent_sequence::resize(size_type new_capacity) {
+  writer.resize(new_capacity);
+}
+
+void concurrent_sequence::start() { writer.start(); }
+
+void concurrent_sequence::advance() { writer.advance(); }
+
+void concurrent_sequence::insert(const value_type &entry) {
+  writer.insert(entry);
+}
+
+void concurrent_sequence::attach(const value_type &entry) {
+  writer.attach(entry);
+}
+
+void concurrent_sequence::remove_current() { writer.remove_current(); }
+
+void concurrent_sequence::insert_range(const value_type items[],
+                                       size_type count) {
+  writer.insert_range(items, count);
+}
+
+void concurrent_sequence::attach_range(const value_type items[],
+                                       size_type count) {
+  writer.attach_range(items, count);
+}
+
+void concurrent_sequence::erase_range(size_type count) {
+  writer.erase_range(count);
+}
+
+concurrent_sequence::size_type concurrent_sequence::size() const {
+  return writer.size();
+}
+
+bool concurrent_sequence::is_item() const { return writer.is_item(); }
+
+concurrent_sequence::value_type concurrent_sequence::current() const {
+  return writer.current();
+}
+
+void concurrent_sequence::publish() {
+  // Make room first (doubling, so the copies stay O(1) amortized), so
+  // the push_back below can't throw once the new version is live.
+  if (retired.size() == retired.capacity())
+    retired.reserve(2 * retired.size() + 1);
+  const sequence *old = latest.exchange(new sequence(writer));
+  retired.push_back(old);
+  reclaim();
+}
+
+concurrent_sequence::size_type concurrent_sequence::retired_count() const {
+  return retired.size();
+}
+
+// READER FUNCTION
+sequence concurrent_sequence::snapshot() const {
+  // Each thread starts looking for a free slot at its own place, so
+  // readers rarely contend for one. The pin must be visible before
+  // latest is read again, and the version must be copied before the pin
+  // is dropped; the default (sequentially consistent) atomics order all
+  // of this with the writer's exchange in publish and its scan of the
+  // slots in reclaim.
+  size_type slot = hash<thread::id>()(this_thread::get_id()) % HAZARD_SLOTS;
+  size_type tried = 0;
+  const sequence *version = latest.load();
+  for (;;) {
+    const sequence *expected = 0;
+    if (hazards[slot].compare_exchange_strong(expected, version)) {
+      const sequence *now = latest.load();
+      if (now == version)
+        break;
+      // Replaced meanwhile (and maybe deleted): pin the newer one.
+      hazards[slot].store(0);
+      version = now;
+    } else {
+      slot = (slot + 1) % HAZARD_SLOTS;
+      if (++tried % HAZARD_SLOTS == 0)
+        this_thread::yield();
+    }
+  }
+
+  struct unpin {
+    atomic<const sequence *> &hazard;
+    ~unpin() { hazard.store(0); }
+  } guard = {hazards[slot]};
+  return sequence(*version);
+}
+
+// HELPER MEMBER FUNCTION
+// Pre:  Called by the writer.
+// Post: Every retired version that no slot of hazards held has been
+//       deleted (a reader pinning it from now on will find latest
+//       changed and let it go), and the rest are still in retired.
+void concurrent_sequence::reclaim() {
+  const sequence *pinned[HAZARD_SLOTS];
+  for (size_type i = 0; i < HAZARD_SLOTS; ++i)
+    pinned[i] = hazards[i].load();
+  sort(pinned, pinned + HAZARD_SLOTS);
+
+  size_type kept = 0;
+  for (size_type i = 0; i < retired.size(); ++i) {
+    if (binary_search(pinned, pinned + HAZARD_SLOTS, retired[i]))
+      retired[kept++] = retired[i];
+    else
+      delete retired[i];
+  }
+  retired.resize(kept);
+}
+} // namespace CS3358_SP2024
@@ -0,0 +1,136 @@
+// FILE: ConcurrentSequence.h
+// CLASS PROVIDED: concurrent_sequence (part of the namespace
+// CS3358_SP2024)
+//
+// A concurrent_sequence lets one writer thread edit a sequence while any
+// number of reader threads take snapshots of it, without either side
+// ever waiting for the other (no locks).
+//
+// The writer uses the usual sequence member functions (listed below; the
+// documentation in Sequence.h applies) on the writer's copy, which
+// readers never see directly. Calling publish makes the writer's copy as
+// it is at that moment the latest version, and snapshot hands readers
+// the latest version as a sequence of their own. Versions are immutable
+// once published: a snapshot never changes, whatever the writer does
+// afterwards (snapshot isolation), and a reader sees each of the
+// writer's edits only once it has been published.
+//
+// Costs: snapshot is O(1) and publish O(HAZARD_SLOTS), since a version
+// shares the writer's storage (copy-on-write, see Sequence.h) rather
+// than copying it. The price is paid by the writer: its first edit after
+// each publish copies its items (O(n)), as the published version still
+// uses the old array. So batching edits between publishes (or
+// publishing only as often as readers need fresh data) keeps writing
+// cheap.
+//
+// Memory: a version replaced by a later publish is freed (at the next
+// publish) as soon as no snapshot call is still copying it, so however
+// busy the readers are, at most HAZARD_SLOTS old versions (and their
+// arrays) are kept alive. At most HAZARD_SLOTS calls to snapshot can
+// copy a version at once; any more wait (yielding) for one to finish.
+//
+// MEMBER CONSTANTS for the concurrent_sequence class:
+//   static const size_type HAZARD_SLOTS = _____
+//    concurrent_sequence::HAZARD_SLOTS is the number of calls to snapshot
+//    that can be copying a version at the same time.
+//
+// CONSTRUCTOR and DESTRUCTOR for the concurrent_sequence class:
+//   concurrent_sequence(size_type initial_capacity = DEFAULT_CAPACITY)
+//    Pre:  initial_capacity > 0
+//    Post: The writer's copy is an empty sequence with the given initial
+//      capacity (see the sequence constructor), and has been published
+//      (so snapshot returns an empty sequence until the next publish).
+//
+//   ~concurrent_sequence()
+//    Pre:  No other thread is in a call to snapshot.
+//    Post: All storage not still used by snapshots has been freed.
+//      Snapshots taken earlier stay valid.
+//
+// WRITER FUNCTIONS (to be called from one thread at a time, the writer):
+//   void resize(size_type new_capacity)
+//   void start()
+//   void advance()
+//   void insert(const value_type& entry)
+//   void attach(const value_type& entry)
+//   void remove_current()
+//   void insert_range(const value_type items[], size_type count)
+//   void attach_range(const value_type items[], size_type count)
+//   void erase_range(size_type count)
+//   size_type size() const
+//   bool is_item() const
+//   value_type current() const
+//    As for sequence, applied to the writer's copy.
+//
+//   void publish()
+//    Pre:  none
+//    Post: The writer's copy, as it is now (items and current item), is
+//      the version that later calls to snapshot will return. Old
+//      versions that no snapshot call is copying have been freed.
+//
+//   size_type retired_count() const
+//    Pre:  none
+//    Post: The return value is the number of old versions not freed yet
+//      (since a snapshot call was copying them at the last publish); it
+//      is never more than HAZARD_SLOTS.
+//
+// READER FUNCTION (may be called by any number of threads at once, and
+// while the writer is in any writer function):
+//   sequence snapshot() const
+//    Pre:  none
+//    Post: The return value is a copy of the latest published version.
+//      It is a sequence like any other (in copy-on-write mode), which the
+//      reader may use, change, copy or keep for as long as it likes.
+//
+// VALUE SEMANTICS for the concurrent_sequence class:
+//   A concurrent_sequence may not be copied or assigned (take a snapshot
+//   instead).
+
+#ifndef CONCURRENT_SEQUENCE_H
+#define CONCURRENT_SEQUENCE_H
+#include <atomic>   // provides atomic
+#include <vector>
+#include "Sequence.h"
+
+namespace CS3358_SP2024
+{
+   class concurrent_sequence
+   {
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef sequence::value_type value_type;
+      typedef sequence::size_type size_type;
+      static const size_type DEFAULT_CAPACITY = sequence::DEFAULT_CAPACITY;
+      static const size_type HAZARD_SLOTS = 64;
+      // CONSTRUCTOR and DESTRUCTOR
+      concurrent_sequence(size_type initial_capacity = DEFAULT_CAPACITY);
+      ~concurrent_sequence();
+      // WRITER FUNCTIONS
+      void resize(size_type new_capacity);
+      void start();
+      void advance();
+      void insert(const value_type& entry);
+      void attach(const value_type& entry);
+      void remove_current();
+      void insert_range(const value_type items[], size_type count);
+      void attach_range(const value_type items[], size_type count);
+      void erase_range(size_type count);
+      size_type size() const;
+      bool is_item() const;
+      value_type current() const;
+      void publish();
+      size_type retired_count() const;
+      // READER FUNCTION
+      sequence snapshot() const;
+   private:
+      sequence writer;
+      std::atomic<const sequence*> latest;
+      mutable std::atomic<const sequence*> hazards[HAZARD_SLOTS];
+      std::vector<const sequence*> retired;
+      concurrent_sequence(const concurrent_sequence&) = delete;
+      concurrent_sequence& operator=(const concurrent_sequence&) = delete;
+      // HELPER MEMBER FUNCTION
+      void reclaim();
+   };
+}
+
+#endif
@@ -0,0 +1,108 @@
+// FILE: ConcurrentSequenceTest.cpp
+//       A non-interactive test program for concurrent_sequence.
+//
+// DESCRIPTION:
+// One writer thread publishes a series of versions while several reader
+// threads take snapshots as fast as they can. Version k holds
+// k % MAX_SIZE + 1 items, all equal to k (version 0, the one published
+// by the constructor, is empty), so every snapshot can be checked on its
+// own: its items must all be the same, their number must match, and a
+// reader must never see an older version after a newer one.
+//
+// Reclamation is checked too: after each publish, retired_count must not
+// exceed HAZARD_SLOTS, however many snapshots overlap, and once the
+// readers have finished, one more publish must free every old version.
+//
+// USAGE:
+//   a3conc [versions [readers]]
+// Prints the number of snapshots checked and "passed", or what went
+// wrong and "FAILED"; the exit status is EXIT_SUCCESS only if it passed.
+
+#include "ConcurrentSequence.h"
+#include <atomic>   // provides atomic
+#include <cstdlib>  // provides atol, EXIT_SUCCESS, EXIT_FAILURE
+#include <iostream> // provides cout
+#include <thread>   // provides thread
+#include <vector>
+using namespace std;
+using namespace CS3358_SP2024;
+
+// The largest number of items in a version.
+const size_t MAX_SIZE = 50;
+
+static atomic<bool> done(false);
+static atomic<bool> failed(false);
+static atomic<size_t> snapshots(0);
+
+// Pre:  cs is being published to by the writer.
+// Post: Snapshots of cs have been taken and checked until done was set;
+//       failed has been set if any was wrong.
+void read_versions(const concurrent_sequence &cs) {
+  double last = 0;
+  size_t taken = 0;
+  while (!done.load() && !failed.load()) {
+    sequence s = cs.snapshot();
+    ++taken;
+    double k = s.size() > 0 ? s[0] : 0;
+    bool ok = k >= last && s.size() == (k == 0 ? 0 : size_t(k) % MAX_SIZE + 1);
+    for (size_t i = 1; ok && i < s.size(); ++i)
+      ok = s[i] == k;
+    if (!ok) {
+      cout << "snapshot of version " << k << " (after version " << last
+           << ") has " << s.size() << " items, not all as expected"
+           << endl;
+      failed.store(true);
+    }
+    last = k;
+  }
+  snapshots.fetch_add(taken);
+}
+
+int main(int argc, char *argv[]) {
+  size_t versions = 20000;
+  size_t readers = 4;
+  if (argc > 1)
+    versions = size_t(atol(argv[1]));
+  if (argc > 2)
+    readers = size_t(atol(argv[2]));
+
+  concurrent_sequence cs;
+  vector<thread> threads;
+  for (size_t r = 0; r < readers; ++r)
+    threads.push_back(thread(read_versions, ref(cs)));
+
+  size_t most_retired = 0;
+  for (size_t k = 1; k <= versions && !failed.load(); ++k) {
+    if (cs.size() > 0) {
+      cs.start();
+      cs.erase_range(cs.size());
+    }
+    for (size_t i = 0; i < k % MAX_SIZE + 1; ++i)
+      cs.attach(double(k));
+    cs.publish();
+    if (cs.retired_count() > most_retired)
+      most_retired = cs.retired_count();
+    if (cs.retired_count() > concurrent_sequence::HAZARD_SLOTS) {
+      cout << "after version " << k << ", " << cs.retired_count()
+           << " old versions are kept (more than HAZARD_SLOTS)" << endl;
+      failed.store(true);
+    }
+    if (k % 64 == 0)
+      this_thread::yield(); // let the readers run, even on one CPU
+  }
+  done.store(true);
+  for (size_t r = 0; r < threads.size(); ++r)
+    threads[r].join();
+
+  cs.publish();
+  if (cs.retired_count() != 0) {
+    cout << "with no readers left, " << cs.retired_count()
+         << " old versions were not freed" << endl;
+    failed.store(true);
+  }
+
+  cout << snapshots.load() << " snapshots checked, at most " << most_retired
+       << " old versions kept: " << (failed.load() ? "FAILED" : "passed")
+       << endl;
+  return failed.load() ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,428 @@
+// FILE: EngineFuzz.cpp
+//       A non-interactive differential test program for the sequence
+//       engines.
+//
+// DESCRIPTION:
+// gap_sequence, rope_sequence, unrolled_sequence and mapped_sequence
+// are put through a long series of random operations, and after each
+// one they are checked against a model (a vector of the items and the
+// position of the current item) that does the same thing the simple
+// way. There are two sequences of each engine but mapped_sequence, so
+// that copies, assignments and (for the rope and unrolled engines)
+// split_at_cursor and splice can move items between them. Sequences
+// grow in bursts to thousands of items, so that ropes get three levels,
+// and are cut back down the same way. Items are compared bit
+// for bit, through current, operator[] and the iterators (both ways).
+//
+// The mapped_sequence is closed and reopened on its file every so
+// often, and must then hold the same items, with no current item.
+// Opening a file that isn't a mapped_sequence file must throw
+// runtime_error.
+//
+// Every so often a compressed_sequence is built from a sequence of
+// repeated, slowly changing and random items (NaNs and zeros of both
+// signs included), and read back with start, advance and seek.
+//
+// USAGE:
+//   a3engines [operations [seed]]
+// Uses (and then removes) the files a3engines.map and a3engines.txt in
+// the current directory. Prints the number of operations checked and
+// "passed", or the first operation that went wrong and "FAILED"; the
+// exit status is EXIT_SUCCESS only if it passed. Building it with
+// -fsanitize=address,undefined also catches what the checks can't see.
+
+#include "CompressedSequence.h"
+#include "GapSequence.h"
+#include "MappedSequence.h"
+#include "RopeSequence.h"
+#include "Sequence.h"
+#include "UnrolledSequence.h"
+#include <algorithm> // provides min
+#include <cstdint>   // provides uint64_t
+#include <cstdio>    // provides remove
+#include <cstdlib>   // provides atol, exit, EXIT_SUCCESS, EXIT_FAILURE
+#include <cstring>   // provides memcmp, memcpy
+#include <fstream>   // provides ofstream
+#include <iostream>  // provides cout
+#include <random>    // provides mt19937_64
+#include <stdexcept> // provides runtime_error
+#include <vector>
+using namespace std;
+using namespace CS3358_SP2024;
+
+// The files mapped_sequence is tested on.
+const char *const MAP_PATH = "a3engines.map";
+const char *const TEXT_PATH = "a3engines.txt";
+// The most items added at once, and the most a sequence may hold before
+// it is cut back (mapped_sequence moves all the later items on every
+// edit, so it is kept smaller).
+const size_t MAX_BURST = 3000;
+const size_t MAX_SIZE = 20000;
+const size_t MAX_MAPPED_SIZE = 5000;
+// Every so many operations the sequences are checked in full (otherwise
+// only the size, the current item and a few others are), and a
+// compressed_sequence is checked.
+const size_t FULL_CHECK_EVERY = 50;
+const size_t COMPRESSED_EVERY = 2000;
+
+// What a sequence should hold: its items, and the position of its
+// current item (items.size() if there is none).
+struct model {
+  vector<double> items;
+  size_t current;
+  model() : current(0) {}
+};
+
+static mt19937_64 rng;
+static size_t op_number = 0;
+static const char *op_name = "";
+
+size_t pick(size_t n) { return n == 0 ? 0 : size_t(rng() % n); }
+
+// Any bit pattern at all, NaNs included, and zeros of both signs.
+double pick_item() {
+  uint64_t bits = rng();
+  if (pick(8) == 0)
+    bits &= uint64_t(1) << 63;
+  double x;
+  memcpy(&x, &bits, sizeof(x));
+  return x;
+}
+
+bool same_bits(double a, double b) { return memcmp(&a, &b, sizeof(a)) == 0; }
+
+void fail(const char *engine, const char *what) {
+  cout << "operation " << op_number << " (" << op_name << "), " << engine
+       << ": " << what << endl
+       << "FAILED" << endl;
+  remove(MAP_PATH);
+  remove(TEXT_PATH);
+  exit(EXIT_FAILURE);
+}
+
+// Pre:  none
+// Post: s has been checked against m (every item if full is true,
+//       otherwise a few), and the program has stopped if they differ.
+template <class Seq>
+void check(const Seq &s, const model &m, const char *engine, bool full) {
+  size_t n = m.items.size();
+  if (s.size() != n)
+    fail(engine, "wrong size");
+  if (s.is_item() != (m.current < n))
+    fail(engine, "wrong is_item");
+  if (m.current < n && !same_bits(s.current(), m.items[m.current]))
+    fail(engine, "wrong current item");
+  if (!full) {
+    for (int k = 0; k < 3 && n > 0; ++k) {
+      size_t i = pick(n);
+      if (!same_bits(s[i], m.items[i]))
+        fail(engine, "wrong item");
+    }
+    return;
+  }
+  for (size_t i = 0; i < n; ++i)
+    if (!same_bits(s[i], m.items[i]))
+      fail(engine, "wrong item");
+  size_t i = 0;
+  typename Seq::const_iterator it = s.begin();
+  for (; it != s.end() && i < n; ++it, ++i)
+    if (!same_bits(*it, m.items[i]))
+      fail(engine, "wrong item through an iterator");
+  if (i != n || it != s.end())
+    fail(engine, "begin to end is not size() items");
+  while (i > 0)
+    if (!same_bits(*--it, m.items[--i]))
+      fail(engine, "wrong item through an iterator going back");
+  if (it != s.begin())
+    fail(engine, "end back to begin is not size() items");
+}
+
+// Pre:  none
+// Post: One random operation that every engine has has been done on s
+//       and on m. Sequences past max_size are cut back to half of that.
+template <class Seq> void step(Seq &s, model &m, size_t max_size) {
+  size_t n = m.items.size();
+  if (n > max_size) {
+    op_name = "cut back";
+    // Remove a run of items from a random place, one by one.
+    size_t first = pick(n / 2);
+    s.start();
+    for (size_t i = 0; i < first; ++i)
+      s.advance();
+    for (size_t i = 0; i < n / 2; ++i)
+      s.remove_current();
+    m.items.erase(m.items.begin() + first, m.items.begin() + first + n / 2);
+    m.current = first;
+    return;
+  }
+  switch (pick(9)) {
+  case 0: {
+    op_name = "insert";
+    double x = pick_item();
+    s.insert(x);
+    if (m.current == n)
+      m.current = 0;
+    m.items.insert(m.items.begin() + m.current, x);
+    break;
+  }
+  case 1: {
+    op_name = "attach";
+    double x = pick_item();
+    s.attach(x);
+    m.current = m.current < n ? m.current + 1 : n;
+    m.items.insert(m.items.begin() + m.current, x);
+    break;
+  }
+  case 2: {
+    op_name = "attach a burst";
+    vector<double> items(1 + pick(MAX_BURST));
+    for (size_t i = 0; i < items.size(); ++i) {
+      items[i] = pick_item();
+      s.attach(items[i]);
+    }
+    size_t at = m.current < n ? m.current + 1 : n;
+    m.items.insert(m.items.begin() + at, items.begin(), items.end());
+    m.current = at + items.size() - 1;
+    break;
+  }
+  case 3:
+    op_name = "remove_current";
+    if (m.current < n) {
+      s.remove_current();
+      m.items.erase(m.items.begin() + m.current);
+    }
+    break;
+  case 4: {
+    op_name = "remove a burst";
+    size_t count = min(pick(MAX_BURST), n - m.current);
+    for (size_t i = 0; i < count; ++i)
+      s.remove_current();
+    m.items.erase(m.items.begin() + m.current,
+                  m.items.begin() + m.current + count);
+    break;
+  }
+  case 5:
+    op_name = "start";
+    s.start();
+    m.current = 0;
+    break;
+  case 6: {
+    op_name = "advance";
+    size_t count = pick(2) == 0 ? 1 : pick(n + 1);
+    for (size_t i = 0; i < count && m.current < n; ++i) {
+      s.advance();
+      ++m.current;
+    }
+    break;
+  }
+  case 7:
+    op_name = "resize";
+    s.resize(pick(2 * n + 40));
+    break;
+  default:
+    op_name = "check";
+    break;
+  }
+}
+
+// Pre:  a and b are not the same sequence.
+// Post: a has been copied to b (copy assignment) or to a new sequence
+//       (copy constructor), and so has ma to mb.
+template <class Seq>
+void step_copy(const Seq &a, const model &ma, Seq &b, model &mb,
+               const char *engine) {
+  if (pick(2) == 0) {
+    op_name = "copy assignment";
+    b = a;
+    mb = ma;
+  } else {
+    op_name = "copy constructor";
+    Seq c(a);
+    check(c, ma, engine, true);
+  }
+}
+
+// Pre:  a and b are not the same sequence.
+// Post: a has been split at its cursor and the items split off spliced
+//       back into a or into b, or b has been spliced into a, and the
+//       same has been done to ma and mb.
+template <class Seq>
+void step_split(Seq &a, model &ma, Seq &b, model &mb, const char *engine) {
+  if (pick(3) != 0) {
+    op_name = "split_at_cursor";
+    Seq tail = a.split_at_cursor();
+    model mt;
+    if (ma.current < ma.items.size()) {
+      mt.items.assign(ma.items.begin() + ma.current, ma.items.end());
+      ma.items.resize(ma.current);
+    }
+    ma.current = ma.items.size();
+    check(tail, mt, engine, true);
+    check(a, ma, engine, true);
+    // Put the items back, or somewhere else.
+    if (pick(2) == 0) {
+      op_name = "splice the split items back";
+      a.splice(tail);
+      ma.items.insert(ma.items.end(), mt.items.begin(), mt.items.end());
+      ma.current = ma.items.size();
+    } else {
+      op_name = "splice the split items into the other";
+      b.splice(tail);
+      mb.items.insert(mb.items.begin() + mb.current, mt.items.begin(),
+                      mt.items.end());
+      mb.current += mt.items.size();
+    }
+    check(tail, model(), engine, true);
+  } else {
+    op_name = "splice";
+    a.splice(b);
+    ma.items.insert(ma.items.begin() + ma.current, mb.items.begin(),
+                    mb.items.end());
+    ma.current += mb.items.size();
+    mb = model();
+  }
+}
+
+// Pre:  none
+// Post: A compressed_sequence has been built from a sequence of random
+//       runs of items and read back, and the program has stopped if any
+//       item differs.
+void check_compressed() {
+  op_name = "compressed_sequence";
+  const char *engine = "compressed_sequence";
+  sequence s;
+  vector<double> items;
+  size_t n = pick(3 * compressed_sequence::BLOCK_SIZE);
+  double x = 0, level = 20;
+  while (items.size() < n) {
+    size_t run = 1 + pick(100);
+    int kind = int(pick(3));
+    for (size_t i = 0; i < run && items.size() < n; ++i) {
+      if (kind == 0)
+        x = pick_item(); // random bits
+      else if (kind == 1)
+        x = level += double(int(pick(3)) - 1) / 10; // slow change
+      // (kind 2 repeats the last item)
+      items.push_back(x);
+    }
+  }
+  if (n > 0)
+    s.attach_range(&items[0], n);
+
+  compressed_sequence c(s);
+  if (c.size() != n || c.is_item())
+    fail(engine, "wrong size, or a current item before start");
+  c.start();
+  for (size_t i = 0; i < n; ++i, c.advance())
+    if (!c.is_item() || !same_bits(c.current(), items[i]))
+      fail(engine, "wrong item from start and advance");
+  if (c.is_item())
+    fail(engine, "still a current item after the last");
+  for (int k = 0; k < 20 && n > 0; ++k) {
+    size_t i = pick(n);
+    c.seek(i);
+    for (size_t j = i; j < n && j < i + 600; ++j, c.advance())
+      if (!c.is_item() || !same_bits(c.current(), items[j]))
+        fail(engine, "wrong item after seek");
+  }
+}
+
+// Pre:  none
+// Post: Opening a text file as a mapped_sequence has been checked to
+//       throw runtime_error.
+void check_not_mapped_file() {
+  op_name = "opening a text file";
+  {
+    ofstream text(TEXT_PATH);
+    for (int i = 0; i < 200; ++i)
+      text << "not a mapped_sequence file\n";
+  }
+  bool thrown = false;
+  try {
+    mapped_sequence m(TEXT_PATH);
+  } catch (const runtime_error &) {
+    thrown = true;
+  }
+  remove(TEXT_PATH);
+  if (!thrown)
+    fail("mapped_sequence", "no runtime_error for a text file");
+}
+
+int main(int argc, char *argv[]) {
+  size_t operations = 20000;
+  size_t seed = 1;
+  if (argc > 1)
+    operations = size_t(atol(argv[1]));
+  if (argc > 2)
+    seed = size_t(atol(argv[2]));
+  rng.seed(seed);
+  remove(MAP_PATH);
+  check_not_mapped_file();
+
+  gap_sequence gaps[2];
+  rope_sequence ropes[2];
+  unrolled_sequence unrolleds[2];
+  mapped_sequence *mapped = new mapped_sequence(MAP_PATH);
+  model gap_models[2], rope_models[2], unrolled_models[2], mapped_model;
+
+  for (op_number = 1; op_number <= operations; ++op_number) {
+    size_t i = pick(2);
+    bool full = op_number % FULL_CHECK_EVERY == 0;
+    switch (pick(4)) {
+    case 0:
+      if (pick(8) == 0)
+        step_copy(gaps[i], gap_models[i], gaps[1 - i], gap_models[1 - i],
+                  "gap_sequence");
+      else
+        step(gaps[i], gap_models[i], MAX_SIZE);
+      check(gaps[i], gap_models[i], "gap_sequence", full);
+      check(gaps[1 - i], gap_models[1 - i], "gap_sequence", full);
+      break;
+    case 1:
+      if (pick(16) == 0)
+        step_copy(ropes[i], rope_models[i], ropes[1 - i], rope_models[1 - i],
+                  "rope_sequence");
+      else if (pick(8) == 0)
+        step_split(ropes[i], rope_models[i], ropes[1 - i],
+                   rope_models[1 - i], "rope_sequence");
+      else
+        step(ropes[i], rope_models[i], MAX_SIZE);
+      check(ropes[i], rope_models[i], "rope_sequence", full);
+      check(ropes[1 - i], rope_models[1 - i], "rope_sequence", full);
+      break;
+    case 2:
+      if (pick(16) == 0)
+        step_copy(unrolleds[i], unrolled_models[i], unrolleds[1 - i],
+                  unrolled_models[1 - i], "unrolled_sequence");
+      else if (pick(8) == 0)
+        step_split(unrolleds[i], unrolled_models[i], unrolleds[1 - i],
+                   unrolled_models[1 - i], "unrolled_sequence");
+      else
+        step(unrolleds[i], unrolled_models[i], MAX_SIZE);
+      check(unrolleds[i], unrolled_models[i], "unrolled_sequence", full);
+      check(unrolleds[1 - i], unrolled_models[1 - i], "unrolled_sequence",
+            full);
+      break;
+    default:
+      if (pick(50) == 0) {
+        op_name = "reopen";
+        delete mapped;
+        mapped = 0;
+        mapped = new mapped_sequence(MAP_PATH);
+        mapped_model.current = mapped_model.items.size();
+        full = true;
+      } else {
+        step(*mapped, mapped_model, MAX_MAPPED_SIZE);
+      }
+      check(*mapped, mapped_model, "mapped_sequence", full);
+      break;
+    }
+    if (op_number % COMPRESSED_EVERY == 0)
+      check_compressed();
+  }
+
+  delete mapped;
+  remove(MAP_PATH);
+  cout << operations << " operations checked: passed" << endl;
+  return EXIT_SUCCESS;
+}
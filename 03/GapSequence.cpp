@@ -0,0 +1,187 @@
+// FILE: GapSequence.cpp
+// CLASS IMPLEMENTED: gap_sequence (see GapSequence.h for documentation)
+// INVARIANT for the gap_sequence ADT:
+//   1. The number of items in the sequence is in the member variable
+//      used;
+//   2. The actual items of the sequence are stored in a dynamic array
+//      pointed to by the member variable data, whose size is in the
+//      member variable capacity. The array holds a block of unused
+//      elements (the gap) from data[gap_start] through data[gap_end-1]
+//      (the gap is empty when gap_start == gap_end), and we don't care
+//      what's stored there. The items of the sequence are stored, in
+//      order, in data[0] through data[gap_start-1] followed by
+//      data[gap_end] through data[capacity-1]; so gap_end - gap_start
+//      is always capacity - used.
+//   3. The index of the current item is in the member variable
+//      current_index; it is a logical index (the position of the item
+//      in the sequence, ignoring the gap), so the current item is stored
+//      in data[current_index] if current_index < gap_start and in
+//      data[current_index + (gap_end - gap_start)] otherwise. If there
+//      is no valid current item, then current_index will be set to the
+//      same number as used (see Sequence.cpp for why this is a good
+//      choice).
+//   4. Where the gap sits does not affect which items are in the
+//      sequence or which is the current item; only the editing functions
+//      move it (start and advance never do).
+
+#include "GapSequence.h"
+#include <cassert>
+#include <stdexcept>
+using namespace std;
+
+namespace CS3358_SP2024 {
+// CONSTRUCTORS and DESTRUCTOR
+gap_sequence::gap_sequence(size_type initial_capacity)
+    : used(0), current_index(0), capacity(initial_capacity), gap_start(0) {
+  if (initial_capacity <= 0)
+    capacity = DEFAULT_CAPACITY;
+  data = new value_type[capacity];
+  gap_end = capacity;
+}
+
+gap_sequence::gap_sequence(const gap_sequence &source)
+    : used(source.used), current_index(source.current_index),
+      capacity(source.capacity), gap_start(source.gap_start),
+      gap_end(source.gap_end) {
+  data = new value_type[capacity];
+  for (size_type i = 0; i < gap_start; ++i)
+    data[i] = source.data[i];
+  for (size_type i = gap_end; i < capacity; ++i)
+    data[i] = source.data[i];
+}
+
+gap_sequence::~gap_sequence() { delete[] data; }
+
+// MODIFICATION MEMBER FUNCTIONS
+void gap_sequence::resize(size_type new_capacity) {
+  if (new_capacity <= 0)
+    new_capacity = 1;
+  if (new_capacity < used)
+    new_capacity = used;
+
+  // The gap stays where it is; only its size changes.
+  size_type tail = capacity - gap_end;
+  value_type *temp = new value_type[new_capacity];
+  for (size_type i = 0; i < gap_start; ++i)
+    temp[i] = data[i];
+  for (size_type i = 0; i < tail; ++i)
+    temp[new_capacity - tail + i] = data[gap_end + i];
+  delete[] data;
+  data = temp;
+  capacity = new_capacity;
+  gap_end = new_capacity - tail;
+}
+
+void gap_sequence::start() { current_index = 0; }
+
+void gap_sequence::advance() {
+  if (is_item())
+    ++current_index;
+}
+
+void gap_sequence::insert(const value_type &entry) {
+  // Copied first: entry may refer into data (through operator[]), which
+  // make_room and move_gap_to may move.
+  value_type item = entry;
+  make_room();
+
+  if (!is_item())
+    current_index = 0;
+  // The new item goes at the end of the gap, so the gap stays just
+  // before the (new) current item for the next insert.
+  move_gap_to(current_index);
+  data[--gap_end] = item;
+  ++used;
+}
+
+void gap_sequence::attach(const value_type &entry) {
+  value_type item = entry; // see insert
+  make_room();
+
+  if (!is_item())
+    current_index = used;
+  else
+    ++current_index;
+
+  // The new item goes at the start of the gap, so the gap stays just
+  // after the (new) current item for the next attach.
+  move_gap_to(current_index);
+  data[gap_start++] = item;
+  ++used;
+}
+
+void gap_sequence::remove_current() {
+  if (is_item()) {
+    // Widening the gap by one drops the item just after it.
+    move_gap_to(current_index);
+    ++gap_end;
+    --used;
+  }
+}
+
+gap_sequence &gap_sequence::operator=(const gap_sequence &source) {
+  if (this != &source) {
+    value_type *temp = new value_type[source.capacity];
+    for (size_type i = 0; i < source.gap_start; ++i)
+      temp[i] = source.data[i];
+    for (size_type i = source.gap_end; i < source.capacity; ++i)
+      temp[i] = source.data[i];
+    delete[] data;
+    data = temp;
+    used = source.used;
+    current_index = source.current_index;
+    capacity = source.capacity;
+    gap_start = source.gap_start;
+    gap_end = source.gap_end;
+  }
+  return *this;
+}
+
+// CONSTANT MEMBER FUNCTIONS
+gap_sequence::size_type gap_sequence::size() const { return used; }
+
+bool gap_sequence::is_item() const { return current_index < used; }
+
+gap_sequence::value_type gap_sequence::current() const {
+  if (!is_item()) {
+    throw std::logic_error("No current item in the sequence.");
+  }
+  return (*this)[current_index];
+}
+
+const gap_sequence::value_type &
+gap_sequence::operator[](size_type index) const {
+  assert(index < used);
+  if (index < gap_start)
+    return data[index];
+  return data[index + (gap_end - gap_start)];
+}
+
+gap_sequence::const_iterator gap_sequence::begin() const {
+  return const_iterator(this, 0);
+}
+
+gap_sequence::const_iterator gap_sequence::end() const {
+  return const_iterator(this, used);
+}
+
+// HELPER MEMBER FUNCTIONS
+// Pre:  index <= used
+// Post: The gap has been moved so that gap_start == index (the items
+//       are unchanged).
+void gap_sequence::move_gap_to(size_type index) {
+  assert(index <= used);
+  while (gap_start > index)
+    data[--gap_end] = data[--gap_start];
+  while (gap_start < index)
+    data[gap_start++] = data[gap_end++];
+}
+
+// Pre:  (none)
+// Post: The gap holds at least one element (the array has been grown if
+//       it was full).
+void gap_sequence::make_room() {
+  if (gap_start == gap_end)
+    resize(capacity * 1.5 + 1);
+}
+} // namespace CS3358_SP2024
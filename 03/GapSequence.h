@@ -0,0 +1,127 @@
+// FILE: GapSequence.h
+// CLASS PROVIDED: gap_sequence (part of the namespace CS3358_SP2024)
+//
+// gap_sequence provides exactly the same interface (typedefs, constants,
+// constructors and member functions) as sequence (see Sequence.h), and
+// the same documentation applies; simply replace sequence with
+// gap_sequence. Only the storage (and so the cost of the operations)
+// differs:
+//
+//   The items are kept in a gap buffer: a dynamic array with a block of
+//   unused slots (the gap) that is kept where the last edit happened.
+//   insert, attach and remove_current move the gap to the current item
+//   before editing, which costs time proportional to the distance the gap
+//   moves; start and advance only move the current item and leave the gap
+//   alone (the gap follows lazily on the next edit). Editing repeatedly at
+//   or next to the current item (e.g. typing at a cursor) is therefore
+//   O(1) (amortized over the occasional resize), instead of O(n) as for
+//   sequence.
+//
+//   gap_sequence::const_iterator is a class rather than a pointer (it
+//   skips over the gap), but is still random-access, and operator[]
+//   is O(1).
+//
+// VALUE SEMANTICS for the gap_sequence class:
+//   Assignments and the copy constructor may be used with gap_sequence
+//   objects.
+
+#ifndef GAP_SEQUENCE_H
+#define GAP_SEQUENCE_H
+#include <cstddef>  // provides ptrdiff_t
+#include <cstdlib>  // provides size_t
+#include <iterator> // provides random_access_iterator_tag
+
+namespace CS3358_SP2024
+{
+   class gap_sequence
+   {
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef double value_type;
+      typedef std::size_t size_type;
+      static const size_type DEFAULT_CAPACITY = 30;
+      class const_iterator;
+      // CONSTRUCTORS and DESTRUCTOR
+      gap_sequence(size_type initial_capacity = DEFAULT_CAPACITY);
+      gap_sequence(const gap_sequence& source);
+      ~gap_sequence();
+      // MODIFICATION MEMBER FUNCTIONS
+      void resize(size_type new_capacity);
+      void start();
+      void advance();
+      void insert(const value_type& entry);
+      void attach(const value_type& entry);
+      void remove_current();
+      gap_sequence& operator=(const gap_sequence& source);
+      // CONSTANT MEMBER FUNCTIONS
+      size_type size() const;
+      bool is_item() const;
+      value_type current() const;
+      const value_type& operator[](size_type index) const;
+      const_iterator begin() const;
+      const_iterator end() const;
+   private:
+      value_type* data;
+      size_type used;
+      size_type current_index;
+      size_type capacity;
+      size_type gap_start;
+      size_type gap_end;
+      // HELPER MEMBER FUNCTIONS
+      void move_gap_to(size_type index);
+      void make_room();
+   };
+
+   // An iterator is a (sequence, position) pair; dereferencing it maps
+   // the position around the gap, as operator[] does.
+   class gap_sequence::const_iterator
+   {
+   public:
+      typedef std::random_access_iterator_tag iterator_category;
+      typedef gap_sequence::value_type value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const value_type* pointer;
+      typedef const value_type& reference;
+      const_iterator() : seq(0), index(0) {}
+      reference operator*() const { return (*seq)[index]; }
+      pointer operator->() const { return &(*seq)[index]; }
+      reference operator[](difference_type n) const
+         { return (*seq)[index + n]; }
+      const_iterator& operator++() { ++index; return *this; }
+      const_iterator& operator--() { --index; return *this; }
+      const_iterator operator++(int)
+         { const_iterator old = *this; ++index; return old; }
+      const_iterator operator--(int)
+         { const_iterator old = *this; --index; return old; }
+      const_iterator& operator+=(difference_type n)
+         { index += n; return *this; }
+      const_iterator& operator-=(difference_type n)
+         { index -= n; return *this; }
+      const_iterator operator+(difference_type n) const
+         { return const_iterator(seq, index + n); }
+      const_iterator operator-(difference_type n) const
+         { return const_iterator(seq, index - n); }
+      difference_type operator-(const const_iterator& other) const
+         { return difference_type(index) - difference_type(other.index); }
+      bool operator==(const const_iterator& other) const
+         { return index == other.index; }
+      bool operator!=(const const_iterator& other) const
+         { return index != other.index; }
+      bool operator<(const const_iterator& other) const
+         { return index < other.index; }
+      bool operator>(const const_iterator& other) const
+         { return index > other.index; }
+      bool operator<=(const const_iterator& other) const
+         { return index <= other.index; }
+      bool operator>=(const const_iterator& other) const
+         { return index >= other.index; }
+   private:
+      friend class gap_sequence;
+      const_iterator(const gap_sequence* s, size_type i)
+         : seq(s), index(i) {}
+      const gap_sequence* seq;
+      size_type index;
+   };
+}
+
+#endif
@@ -0,0 +1,248 @@
+// FILE: MappedSequence.cpp
+// CLASS IMPLEMENTED: mapped_sequence (see MappedSequence.h for
+// documentation)
+// INVARIANT for the mapped_sequence ADT:
+//   1. fd is the open file, and its first map_bytes bytes are mapped
+//      (shared, read and write) at map. map_bytes is always a whole
+//      number of pages. The mapping covers the whole file, except after
+//      a failed attempt to grow it, which can leave the file longer (the
+//      extra pages just become spare capacity when the file is next
+//      opened).
+//   2. header points to the start of the mapping (a file_header), and
+//      data to just after it; the file holds room for capacity items,
+//      capacity being (map_bytes - sizeof(file_header)) /
+//      sizeof(value_type).
+//   3. As for sequence, the number of items is in the member variable
+//      used, and the items are in data[0] through data[used-1]. used is
+//      also kept in header->used (set_used updates both), so that the
+//      file always records how many of its items are in use.
+//   4. As for sequence, the index of the current item is in the member
+//      variable current_index, which is the same number as used if
+//      there is no current item. It is not stored in the file.
+
+#include "MappedSequence.h"
+#include <cassert>
+#include <cerrno>
+#include <cstring>      // provides memcmp, memcpy, memmove
+#include <fcntl.h>      // provides open
+#include <stdexcept>    // provides logic_error, runtime_error
+#include <string>
+#include <sys/mman.h>   // provides mmap, mremap, munmap, msync
+#include <sys/stat.h>   // provides fstat
+#include <system_error> // provides system_error
+#include <unistd.h>     // provides close, ftruncate, sysconf
+using namespace std;
+
+namespace {
+const char MAGIC[8] = {'S', 'E', 'Q', 'D', 'B', 'L', '0', '1'};
+
+// Throws a system_error for the current errno.
+void fail(const string &what) {
+  throw system_error(errno, generic_category(), what);
+}
+} // namespace
+
+namespace CS3358_SP2024 {
+// CONSTRUCTOR and DESTRUCTOR
+mapped_sequence::mapped_sequence(const char *path,
+                                 size_type initial_capacity)
+    : fd(-1), map(MAP_FAILED), map_bytes(0), header(0), data(0), used(0),
+      current_index(0), capacity(0) {
+  fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (fd < 0)
+    fail(string("open ") + path);
+
+  try {
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+      fail(string("fstat ") + path);
+    size_type bytes = st.st_size;
+    bool is_new = (bytes == 0);
+    if (is_new) {
+      if (initial_capacity <= 0)
+        initial_capacity = DEFAULT_CAPACITY;
+      bytes = file_bytes(initial_capacity);
+      if (ftruncate(fd, bytes) != 0)
+        fail(string("ftruncate ") + path);
+    } else if (bytes < sizeof(file_header)) {
+      throw runtime_error(string(path) + " is not a mapped_sequence file");
+    }
+
+    map = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED)
+      fail(string("mmap ") + path);
+    map_bytes = bytes;
+    header = static_cast<file_header *>(map);
+    data = reinterpret_cast<value_type *>(header + 1);
+    capacity = (map_bytes - sizeof(file_header)) / sizeof(value_type);
+
+    if (is_new) {
+      memcpy(header->magic, MAGIC, sizeof(MAGIC));
+      set_used(0);
+    } else if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 ||
+               header->used > capacity) {
+      throw runtime_error(string(path) + " is not a mapped_sequence file");
+    }
+    used = header->used;
+    current_index = used;
+  } catch (...) {
+    if (map != MAP_FAILED)
+      munmap(map, map_bytes);
+    close(fd);
+    throw;
+  }
+}
+
+mapped_sequence::~mapped_sequence() {
+  munmap(map, map_bytes);
+  close(fd);
+}
+
+// MODIFICATION MEMBER FUNCTIONS
+void mapped_sequence::resize(size_type new_capacity) {
+  if (new_capacity <= 0)
+    new_capacity = 1;
+  if (new_capacity < used)
+    new_capacity = used;
+
+  size_type new_bytes = file_bytes(new_capacity);
+  if (new_bytes > map_bytes) {
+    // The file must be as long as the mapping before it is touched. If
+    // the remap then fails, the file is just left longer than the
+    // mapping (see invariant 1).
+    if (ftruncate(fd, new_bytes) != 0)
+      fail("ftruncate");
+    remap(new_bytes);
+  } else if (new_bytes < map_bytes) {
+    remap(new_bytes);
+    if (ftruncate(fd, new_bytes) != 0)
+      fail("ftruncate");
+  }
+}
+
+void mapped_sequence::start() { current_index = 0; }
+
+void mapped_sequence::advance() {
+  if (is_item())
+    ++current_index;
+}
+
+void mapped_sequence::insert(const value_type &entry) {
+  // Copied first: entry may refer into data (through operator[]), which
+  // make_room may remap.
+  value_type item = entry;
+  make_room();
+  if (!is_item())
+    current_index = 0;
+  memmove(data + current_index + 1, data + current_index,
+          (used - current_index) * sizeof(value_type));
+  data[current_index] = item;
+  set_used(used + 1);
+}
+
+void mapped_sequence::attach(const value_type &entry) {
+  value_type item = entry; // see insert
+  make_room();
+  if (!is_item())
+    current_index = used;
+  else
+    ++current_index;
+  memmove(data + current_index + 1, data + current_index,
+          (used - current_index) * sizeof(value_type));
+  data[current_index] = item;
+  set_used(used + 1);
+}
+
+void mapped_sequence::remove_current() {
+  if (is_item()) {
+    memmove(data + current_index, data + current_index + 1,
+            (used - current_index - 1) * sizeof(value_type));
+    set_used(used - 1);
+  }
+}
+
+void mapped_sequence::sync() {
+  if (msync(map, map_bytes, MS_SYNC) != 0)
+    fail("msync");
+}
+
+// CONSTANT MEMBER FUNCTIONS
+mapped_sequence::size_type mapped_sequence::size() const { return used; }
+
+bool mapped_sequence::is_item() const { return current_index < used; }
+
+mapped_sequence::value_type mapped_sequence::current() const {
+  if (!is_item()) {
+    throw std::logic_error("No current item in the sequence.");
+  }
+  return data[current_index];
+}
+
+const mapped_sequence::value_type &
+mapped_sequence::operator[](size_type index) const {
+  assert(index < used);
+  return data[index];
+}
+
+mapped_sequence::const_iterator mapped_sequence::begin() const {
+  return data;
+}
+
+mapped_sequence::const_iterator mapped_sequence::end() const {
+  return data + used;
+}
+
+// HELPER MEMBER FUNCTIONS
+// Pre:  The file is at least new_bytes long, and new_bytes is a whole
+//       number of pages.
+// Post: The first new_bytes of the file are mapped in place of the old
+//       mapping (which may have moved, taking header and data along),
+//       and capacity has been updated to match. If the mapping can't be
+//       changed, system_error is thrown and the old mapping is kept.
+void mapped_sequence::remap(size_type new_bytes) {
+#ifdef MREMAP_MAYMOVE
+  // Linux can move or grow the mapping without unmapping it first.
+  void *p = mremap(map, map_bytes, new_bytes, MREMAP_MAYMOVE);
+  if (p == MAP_FAILED)
+    fail("mremap");
+#else
+  void *p = mmap(0, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (p == MAP_FAILED)
+    fail("mmap");
+  munmap(map, map_bytes);
+#endif
+  map = p;
+  map_bytes = new_bytes;
+  header = static_cast<file_header *>(map);
+  data = reinterpret_cast<value_type *>(header + 1);
+  capacity = (map_bytes - sizeof(file_header)) / sizeof(value_type);
+}
+
+// Pre:  new_used <= capacity
+// Post: used and header->used are both new_used.
+void mapped_sequence::set_used(size_type new_used) {
+  assert(new_used <= capacity);
+  used = new_used;
+  header->used = new_used;
+}
+
+// Pre:  (none)
+// Post: There is room for at least one more item (the file has been
+//       grown by half if it was full).
+void mapped_sequence::make_room() {
+  if (used == capacity)
+    resize(capacity + capacity / 2 + 1);
+}
+
+// Pre:  (none)
+// Post: The return value is the size of a file with room for at least
+//       capacity items, rounded up to a whole number of pages.
+mapped_sequence::size_type mapped_sequence::file_bytes(size_type capacity) {
+  size_type page = sysconf(_SC_PAGESIZE);
+  if (capacity > (size_type(-1) - sizeof(file_header) - page) /
+                     sizeof(value_type))
+    throw length_error("mapped_sequence capacity overflow");
+  size_type bytes = sizeof(file_header) + capacity * sizeof(value_type);
+  return (bytes + page - 1) / page * page;
+}
+} // namespace CS3358_SP2024
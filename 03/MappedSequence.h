@@ -0,0 +1,128 @@
+// FILE: MappedSequence.h
+// CLASS PROVIDED: mapped_sequence (part of the namespace CS3358_SP2024)
+//
+// mapped_sequence provides this part of the interface of sequence (see
+// Sequence.h), for which the same documentation applies (simply replace
+// sequence with mapped_sequence):
+//   typedefs value_type, size_type and const_iterator (a plain pointer)
+//   DEFAULT_CAPACITY
+//   resize, start, advance, insert, attach, remove_current
+//   size, is_item, current, operator[], begin, end
+// It has none of the rest: no shrink_to_fit, insert_range, attach_range,
+// erase_range, split_at_cursor, splice, seek_lower_bound, insert_sorted,
+// sort, parallel_sort, remove_if, slice, copy-on-write (copy_on_write,
+// is_copy_on_write), memory resources (get_resource), copying, moving
+// or swap. Its constructor and destructor differ too (see below).
+//
+// What is new is that its items live in a file rather than in memory:
+// the file is mapped into memory (mmap), and the dynamic array of
+// sequence is simply the mapped part of the file after a small header.
+// Changes to the items go straight to the file (through the operating
+// system's page cache), so a mapped_sequence opened on the same file
+// later (even by another program) sees them. Opening a sequence takes
+// the same (short) time however many items it holds, since items are
+// read from the file only when they are used, and the operating system
+// can evict pages that haven't been used lately when memory is short.
+//
+// The file holds the items as raw doubles in this machine's byte order,
+// so it can't be moved to a machine with a different byte order. Items
+// that have been changed are written to disk by the operating system
+// when it sees fit, or when sync is called; a crash of the machine (not
+// just of the program) can lose changes made since the last sync.
+//
+// CONSTRUCTOR and DESTRUCTOR for the mapped_sequence class (in place of
+// those of sequence):
+//   mapped_sequence(const char* path,
+//                   size_type initial_capacity = DEFAULT_CAPACITY)
+//    Pre:  path names a file that can be opened for reading and
+//      writing, or created.
+//    Post: If the file exists and isn't empty, the sequence holds the
+//      items stored in it (by an earlier mapped_sequence); otherwise
+//      the file has been created (or grown) to hold an empty sequence
+//      with room for at least initial_capacity items. Either way there
+//      is no current item. Throws std::system_error if the file can't
+//      be opened, created or mapped, and std::runtime_error if it isn't
+//      a mapped_sequence file.
+//    Note: The capacity is always rounded up so that the file is a
+//      whole number of pages, so resize may leave it a little larger
+//      than new_capacity.
+//
+//   ~mapped_sequence()
+//    Post: The file has been unmapped and closed (its contents are kept).
+//
+// MODIFICATION MEMBER FUNCTION (in addition to those listed above):
+//   void sync()
+//    Pre:  none
+//    Post: All changes made so far have been written to disk (msync).
+//      Throws std::system_error if that fails.
+//
+// Modification member functions (and resize) throw std::system_error if
+// the file can't be grown or remapped; the sequence is then unchanged.
+//
+// VALUE SEMANTICS for the mapped_sequence class:
+//   A mapped_sequence owns its open file, so it may not be copied or
+//   assigned. Two mapped_sequence objects must not be open on the same
+//   file at once.
+
+#ifndef MAPPED_SEQUENCE_H
+#define MAPPED_SEQUENCE_H
+#include <cstdint>  // provides uint64_t
+#include <cstdlib>  // provides size_t
+
+namespace CS3358_SP2024
+{
+   class mapped_sequence
+   {
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef double value_type;
+      typedef std::size_t size_type;
+      static const size_type DEFAULT_CAPACITY = 30;
+      typedef const value_type* const_iterator;
+      // CONSTRUCTOR and DESTRUCTOR
+      explicit mapped_sequence(const char* path,
+                               size_type initial_capacity = DEFAULT_CAPACITY);
+      ~mapped_sequence();
+      // MODIFICATION MEMBER FUNCTIONS
+      void resize(size_type new_capacity);
+      void start();
+      void advance();
+      void insert(const value_type& entry);
+      void attach(const value_type& entry);
+      void remove_current();
+      void sync();
+      // CONSTANT MEMBER FUNCTIONS
+      size_type size() const;
+      bool is_item() const;
+      value_type current() const;
+      const value_type& operator[](size_type index) const;
+      const_iterator begin() const;
+      const_iterator end() const;
+   private:
+      // The start of the file; the items follow it, from byte
+      // sizeof(file_header) (a whole number of cache lines) on.
+      struct file_header
+      {
+         char magic[8];
+         std::uint64_t used;
+         char reserved[48];
+      };
+      int fd;
+      void* map;
+      size_type map_bytes;
+      file_header* header;
+      value_type* data;
+      size_type used;
+      size_type current_index;
+      size_type capacity;
+      mapped_sequence(const mapped_sequence&) = delete;
+      mapped_sequence& operator=(const mapped_sequence&) = delete;
+      // HELPER MEMBER FUNCTIONS
+      void remap(size_type new_bytes);
+      void set_used(size_type new_used);
+      void make_room();
+      static size_type file_bytes(size_type capacity);
+   };
+}
+
+#endif
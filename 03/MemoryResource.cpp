@@ -0,0 +1,108 @@
+// FILE: MemoryResource.cpp
+// CLASSES IMPLEMENTED: memory_resource, monotonic_arena (see
+// MemoryResource.h for documentation)
+// INVARIANT for the monotonic_arena class:
+//   1. The memory still to be handed out is next_free through end-1
+//      (next_free == end when there is none); it lies in buffer (the
+//      caller's buffer, if any, of buffer_size bytes) or in the most
+//      recently allocated chunk.
+//   2. chunks points to the most recently allocated chunk from upstream,
+//      each chunk points to the one allocated before it, and the last
+//      points to 0 (chunks is 0 if none has been allocated since the
+//      arena was constructed or last released). A chunk's size is the
+//      number of bytes it was allocated with, header included.
+//   3. next_chunk_size is the minimum size of the next chunk to be
+//      allocated; it starts at first_chunk_size and doubles each time.
+
+#include "MemoryResource.h"
+#include <cstdint> // provides uintptr_t
+#include <new>     // provides operator new, bad_alloc
+using namespace std;
+
+namespace {
+// The resource returned by new_delete_resource. operator new already
+// aligns to alignof(max_align_t), which is all sequences ask for.
+class new_delete_memory_resource : public CS3358_SP2024::memory_resource {
+  void *do_allocate(size_t bytes, size_t) { return ::operator new(bytes); }
+  void do_deallocate(void *p, size_t, size_t) { ::operator delete(p); }
+  bool do_is_equal(const memory_resource &other) const {
+    return this == &other;
+  }
+};
+
+// Pre:  alignment is a power of two.
+// Post: The return value is p rounded up to a multiple of alignment.
+char *align_up(char *p, size_t alignment) {
+  uintptr_t n = reinterpret_cast<uintptr_t>(p);
+  n = (n + alignment - 1) & ~uintptr_t(alignment - 1);
+  return reinterpret_cast<char *>(n);
+}
+} // namespace
+
+namespace CS3358_SP2024 {
+memory_resource *new_delete_resource() {
+  static new_delete_memory_resource resource;
+  return &resource;
+}
+
+// CONSTRUCTORS and DESTRUCTOR
+monotonic_arena::monotonic_arena(size_t chunk_size,
+                                 memory_resource *upstream)
+    : upstream(upstream), chunks(0), next_free(0), end(0),
+      next_chunk_size(chunk_size), first_chunk_size(chunk_size), buffer(0),
+      buffer_size(0) {}
+
+monotonic_arena::monotonic_arena(void *buffer, size_t buffer_size,
+                                 memory_resource *upstream)
+    : upstream(upstream), chunks(0), next_free(static_cast<char *>(buffer)),
+      end(static_cast<char *>(buffer) + buffer_size),
+      next_chunk_size(DEFAULT_CHUNK_SIZE),
+      first_chunk_size(DEFAULT_CHUNK_SIZE),
+      buffer(static_cast<char *>(buffer)), buffer_size(buffer_size) {}
+
+monotonic_arena::~monotonic_arena() { release(); }
+
+// MODIFICATION MEMBER FUNCTIONS
+void monotonic_arena::release() {
+  while (chunks != 0) {
+    chunk *c = chunks;
+    chunks = c->next;
+    upstream->deallocate(c, c->size);
+  }
+  next_free = buffer;
+  end = buffer + buffer_size;
+  next_chunk_size = first_chunk_size;
+}
+
+// HELPER MEMBER FUNCTIONS
+void *monotonic_arena::do_allocate(size_t bytes, size_t alignment) {
+  char *p = next_free != 0 ? align_up(next_free, alignment) : 0;
+  if (p == 0 || p > end || size_t(end - p) < bytes) {
+    // Start a new chunk big enough for the header, the padding to
+    // align the first block, and the block itself.
+    size_t needed = sizeof(chunk) + alignment + bytes;
+    if (needed < bytes)
+      throw bad_alloc();
+    size_t size = next_chunk_size > needed ? next_chunk_size : needed;
+    chunk *c = static_cast<chunk *>(upstream->allocate(size));
+    c->next = chunks;
+    c->size = size;
+    chunks = c;
+    next_free = reinterpret_cast<char *>(c + 1);
+    end = reinterpret_cast<char *>(c) + size;
+    if (next_chunk_size < size_t(-1) / 2)
+      next_chunk_size *= 2;
+    p = align_up(next_free, alignment);
+  }
+  next_free = p + bytes;
+  return p;
+}
+
+void monotonic_arena::do_deallocate(void *, size_t, size_t) {
+  // Memory is given back only by release.
+}
+
+bool monotonic_arena::do_is_equal(const memory_resource &other) const {
+  return this == &other;
+}
+} // namespace CS3358_SP2024
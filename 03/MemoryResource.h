@@ -0,0 +1,143 @@
+// FILE: MemoryResource.h
+// CLASSES PROVIDED: memory_resource, monotonic_arena (part of the
+// namespace CS3358_SP2024)
+//
+// memory_resource is an abstract source of raw memory that a sequence
+// can be given to allocate its storage from (see Sequence.h). It has the
+// same interface as C++17's std::pmr::memory_resource, so where that is
+// available an adapter that forwards the three do_ functions to a
+// std::pmr::memory_resource is all it takes to use any pmr resource.
+//
+// monotonic_arena is a memory_resource that hands out memory from large
+// chunks, one after another, and never gives any back until release is
+// called (or the arena is destroyed), which frees everything at once.
+// Allocation is just a pointer bump, and deallocation does nothing, so
+// many short-lived sequences can be carved out of one arena (for
+// example, one per request) and dropped together, without fragmenting
+// the heap. Memory a sequence frees while it grows is not reused, so
+// an arena suits sequences whose final sizes are known or small.
+//
+// MEMBER FUNCTIONS for the memory_resource class:
+//   void* allocate(size_t bytes,
+//                  size_t alignment = alignof(std::max_align_t))
+//    Pre:  alignment is a power of two.
+//    Post: The return value points to at least bytes bytes of memory,
+//      aligned to a multiple of alignment. Throws bad_alloc if the
+//      memory can't be had.
+//
+//   void deallocate(void* p, size_t bytes,
+//                   size_t alignment = alignof(std::max_align_t))
+//    Pre:  p was returned by allocate(bytes, alignment) on this resource
+//      (or one that is_equal to it) and hasn't been deallocated since.
+//    Post: The memory at p has been given back to the resource.
+//
+//   bool is_equal(const memory_resource& other) const
+//    Pre:  none
+//    Post: The return value is true if memory allocated from either of
+//      the two resources may be deallocated through the other.
+//
+//   A derived resource implements these by overriding do_allocate,
+//   do_deallocate and do_is_equal, which take the same arguments.
+//
+// NON-MEMBER FUNCTIONS:
+//   memory_resource* new_delete_resource()
+//    Pre:  none
+//    Post: The return value points to a resource (shared by all
+//      callers) that allocates with the global operator new and
+//      deallocates with operator delete.
+//
+// CONSTRUCTORS and DESTRUCTOR for the monotonic_arena class:
+//   monotonic_arena(size_t chunk_size = DEFAULT_CHUNK_SIZE,
+//                   memory_resource* upstream = new_delete_resource())
+//    Pre:  upstream is not 0.
+//    Post: The arena is empty. Its chunks will be allocated from
+//      upstream, the first one chunk_size bytes (or more, if a single
+//      allocation needs it) and each one after that twice as large as
+//      the one before.
+//
+//   monotonic_arena(void* buffer, size_t buffer_size,
+//                   memory_resource* upstream = new_delete_resource())
+//    Pre:  buffer points to buffer_size bytes that outlive the arena,
+//      and upstream is not 0.
+//    Post: The arena is empty, and will hand out the memory in buffer
+//      (e.g. a local array) before it allocates any chunk from upstream.
+//
+//   ~monotonic_arena()
+//    Post: Same as release().
+//
+// MODIFICATION MEMBER FUNCTIONS for the monotonic_arena class:
+//   void release()
+//    Pre:  none
+//    Post: Every chunk the arena allocated has been given back to
+//      upstream, and the arena is empty again (everything allocated
+//      from it so far is gone, so it must no longer be in use).
+//
+// VALUE SEMANTICS for the monotonic_arena class:
+//   A monotonic_arena may not be copied or assigned.
+
+#ifndef MEMORY_RESOURCE_H
+#define MEMORY_RESOURCE_H
+#include <cstddef>  // provides size_t, max_align_t
+
+namespace CS3358_SP2024
+{
+   class memory_resource
+   {
+   public:
+      virtual ~memory_resource() {}
+      void* allocate(std::size_t bytes,
+                     std::size_t alignment = alignof(std::max_align_t))
+         { return do_allocate(bytes, alignment); }
+      void deallocate(void* p, std::size_t bytes,
+                      std::size_t alignment = alignof(std::max_align_t))
+         { do_deallocate(p, bytes, alignment); }
+      bool is_equal(const memory_resource& other) const
+         { return do_is_equal(other); }
+   private:
+      virtual void* do_allocate(std::size_t bytes,
+                                std::size_t alignment) = 0;
+      virtual void do_deallocate(void* p, std::size_t bytes,
+                                 std::size_t alignment) = 0;
+      virtual bool do_is_equal(const memory_resource& other) const = 0;
+   };
+
+   memory_resource* new_delete_resource();
+
+   class monotonic_arena : public memory_resource
+   {
+   public:
+      static const std::size_t DEFAULT_CHUNK_SIZE = 4096;
+      // CONSTRUCTORS and DESTRUCTOR
+      explicit monotonic_arena(std::size_t chunk_size = DEFAULT_CHUNK_SIZE,
+                               memory_resource* upstream =
+                                  new_delete_resource());
+      monotonic_arena(void* buffer, std::size_t buffer_size,
+                      memory_resource* upstream = new_delete_resource());
+      ~monotonic_arena();
+      // MODIFICATION MEMBER FUNCTIONS
+      void release();
+   private:
+      // Each chunk from upstream starts with this header, which links
+      // it into the list of chunks to give back on release.
+      struct chunk
+      {
+         chunk* next;
+         std::size_t size;
+      };
+      memory_resource* upstream;
+      chunk* chunks;
+      char* next_free;
+      char* end;
+      std::size_t next_chunk_size;
+      std::size_t first_chunk_size;
+      char* buffer;
+      std::size_t buffer_size;
+      monotonic_arena(const monotonic_arena&) = delete;
+      monotonic_arena& operator=(const monotonic_arena&) = delete;
+      void* do_allocate(std::size_t bytes, std::size_t alignment);
+      void do_deallocate(void* p, std::size_t bytes, std::size_t alignment);
+      bool do_is_equal(const memory_resource& other) const;
+   };
+}
+
+#endif
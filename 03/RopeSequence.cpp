@@ -0,0 +1,695 @@
+// FILE: RopeSequence.cpp
+// CLASS IMPLEMENTED: rope_sequence (see RopeSequence.h for documentation)
+// INVARIANT for the rope_sequence ADT:
+//   1. The number of items in the sequence is in the member variable
+//      used;
+//   2. The items are stored in leaf nodes, each holding from 1 to
+//      LEAF_CAPACITY items in items[0] through items[count-1]. The only
+//      leaf that may be empty is the root of an empty sequence.
+//   3. The leaves are the bottom level of a tree rooted at the member
+//      variable root; every inner node has from 1 to FANOUT children
+//      (in children[0] through children[n_children-1]), all leaves are
+//      at the same depth, and every node's parent member points back at
+//      the inner node above it (0 for the root). Every node's count is
+//      the number of items in its subtree, so root->count == used.
+//   4. Reading the leaves from left to right gives the items of the
+//      sequence in order. The leaves are also linked in that order
+//      through prev/next, and the member variables first and last point
+//      at the leftmost and rightmost leaf.
+//   5. The index of the current item is in the member variable
+//      current_index. If there is no valid current item, then
+//      current_index will be set to the same number as used (see
+//      Sequence.cpp for why this is a good choice). When there is a
+//      current item, it is current_leaf->items[current_offset].
+//   6. Nodes are kept from getting too sparse: when a leaf drops below
+//      a quarter full (or an inner node below a quarter of FANOUT
+//      children), it is merged with an adjacent sibling if the two fit
+//      in one node. So every pair of adjacent siblings is at least
+//      about half full, and the height of the tree stays O(log used).
+
+#include "RopeSequence.h"
+#include <cassert>
+#include <stdexcept>
+#include <vector>
+using namespace std;
+
+namespace CS3358_SP2024 {
+// CONSTRUCTORS and DESTRUCTOR
+rope_sequence::rope_sequence(size_type initial_capacity)
+    : used(0), current_index(0), current_leaf(0), current_offset(0) {
+  root = first = last = new_leaf();
+}
+
+rope_sequence::rope_sequence(const rope_sequence &source)
+    : used(source.used), current_index(source.current_index) {
+  copy_items(source);
+  sync_current();
+}
+
+rope_sequence::~rope_sequence() { destroy(root); }
+
+// MODIFICATION MEMBER FUNCTIONS
+void rope_sequence::resize(size_type new_capacity) {
+  // Storage is allocated a leaf at a time; there's no capacity to change.
+}
+
+void rope_sequence::start() {
+  current_index = 0;
+  sync_current();
+}
+
+void rope_sequence::advance() {
+  if (is_item()) {
+    ++current_index;
+    if (++current_offset == current_leaf->count && current_leaf->next != 0) {
+      current_leaf = current_leaf->next;
+      current_offset = 0;
+    }
+  }
+}
+
+void rope_sequence::insert(const value_type &entry) {
+  if (!is_item())
+    current_index = 0;
+  insert_at(current_index, entry);
+}
+
+void rope_sequence::attach(const value_type &entry) {
+  if (!is_item())
+    current_index = used;
+  else
+    ++current_index;
+  insert_at(current_index, entry);
+}
+
+void rope_sequence::remove_current() {
+  if (is_item()) {
+    leaf_node *leaf = current_leaf;
+    for (size_type i = current_offset + 1; i < leaf->count; ++i)
+      leaf->items[i - 1] = leaf->items[i];
+    for (node *n = leaf; n != 0; n = n->parent)
+      --n->count;
+    --used;
+
+    if (leaf->count < LEAF_CAPACITY / 4)
+      rebalance(leaf);
+    // current_index now refers to the item after the removed one.
+    sync_current();
+  }
+}
+
+rope_sequence rope_sequence::split_at_cursor() {
+  rope_sequence tail;
+  if (!is_item())
+    return tail;
+  // Allocate everything first, so that nothing is changed if that
+  // fails: a leaf for the cut (or, if everything moves, a new empty one
+  // for this), and the inner nodes of two trees over at most n_leaves
+  // leaves each. Nothing after this can throw.
+  size_type n_leaves = count_leaves() + 1;
+  vector<node *> kept, moved;
+  kept.reserve(n_leaves);
+  moved.reserve(n_leaves);
+  node_stock stock(current_offset > 0 || current_index == 0 ? 1 : 0,
+                   2 * inner_nodes_for(n_leaves));
+
+  leaf_node *cut = current_leaf;
+  if (current_offset > 0)
+    cut = cut_leaf(current_leaf, current_offset, stock.take_leaf());
+  for (leaf_node *leaf = first; leaf != cut; leaf = leaf->next)
+    kept.push_back(leaf);
+  for (leaf_node *leaf = cut; leaf != 0; leaf = leaf->next)
+    moved.push_back(leaf);
+  destroy_inner(root);
+  destroy(tail.root);
+  relink(kept, stock);
+  tail.relink(moved, stock);
+
+  tail.used = used - current_index;
+  tail.current_index = 0;
+  tail.sync_current();
+  used = current_index;
+  sync_current();
+  return tail;
+}
+
+void rope_sequence::splice(rope_sequence &other) {
+  assert(&other != this);
+  if (other.used == 0)
+    return;
+  // Allocate everything first, as in split_at_cursor: leaves for other's
+  // new empty root and for the cut, and the inner nodes of a tree over
+  // at most n_leaves leaves. Nothing after this can throw.
+  size_type n_leaves = count_leaves() + other.count_leaves() + 1;
+  vector<node *> leaves;
+  leaves.reserve(n_leaves);
+  node_stock stock(2, inner_nodes_for(n_leaves));
+  leaf_node *other_root = stock.take_leaf();
+  // The items go before the current item, or after the last one (where
+  // locate puts the end).
+  leaf_node *leaf, *after;
+  size_type offset;
+  locate(current_index, leaf, offset);
+  if (offset == 0)
+    after = leaf;
+  else if (offset < leaf->count)
+    after = cut_leaf(leaf, offset, stock.take_leaf());
+  else
+    after = leaf->next;
+
+  for (leaf_node *l = first; l != after; l = l->next)
+    leaves.push_back(l);
+  for (leaf_node *l = other.first; l != 0; l = l->next)
+    leaves.push_back(l);
+  for (leaf_node *l = after; l != 0; l = l->next)
+    leaves.push_back(l);
+  destroy_inner(root);
+  destroy_inner(other.root);
+  relink(leaves, stock);
+  // Still the same current item (or still none).
+  used += other.used;
+  current_index += other.used;
+  sync_current();
+
+  other.root = other.first = other.last = other_root;
+  other.used = other.current_index = 0;
+  other.sync_current();
+}
+
+rope_sequence &rope_sequence::operator=(const rope_sequence &source) {
+  if (this != &source) {
+    node *old_root = root;
+    copy_items(source);
+    destroy(old_root);
+    used = source.used;
+    current_index = source.current_index;
+    sync_current();
+  }
+  return *this;
+}
+
+// CONSTANT MEMBER FUNCTIONS
+rope_sequence::size_type rope_sequence::size() const { return used; }
+
+bool rope_sequence::is_item() const { return current_index < used; }
+
+rope_sequence::value_type rope_sequence::current() const {
+  if (!is_item()) {
+    throw std::logic_error("No current item in the sequence.");
+  }
+  return current_leaf->items[current_offset];
+}
+
+const rope_sequence::value_type &
+rope_sequence::operator[](size_type index) const {
+  assert(index < used);
+  leaf_node *leaf;
+  size_type offset;
+  locate(index, leaf, offset);
+  return leaf->items[offset];
+}
+
+rope_sequence::const_iterator rope_sequence::begin() const {
+  // An empty sequence's only leaf is empty, so begin() == end() there.
+  return const_iterator(first, 0);
+}
+
+rope_sequence::const_iterator rope_sequence::end() const {
+  return const_iterator(last, last->count);
+}
+
+// HELPER MEMBER FUNCTIONS
+// Pre:  (none)
+// Post: If index < used, leaf->items[offset] is the item at position
+//       index; otherwise leaf is the last leaf and offset its count (the
+//       position just past the last item).
+void rope_sequence::locate(size_type index, leaf_node *&leaf,
+                           size_type &offset) const {
+  if (index >= used) {
+    leaf = last;
+    offset = last->count;
+    return;
+  }
+  node *n = root;
+  while (!n->is_leaf) {
+    inner_node *inner = static_cast<inner_node *>(n);
+    size_type i = 0;
+    while (index >= inner->children[i]->count) {
+      index -= inner->children[i]->count;
+      ++i;
+    }
+    n = inner->children[i];
+  }
+  leaf = static_cast<leaf_node *>(n);
+  offset = index;
+}
+
+// Pre:  current_index <= used
+// Post: current_leaf and current_offset have been set to match
+//       current_index (invariant 5).
+void rope_sequence::sync_current() {
+  locate(current_index, current_leaf, current_offset);
+}
+
+// Pre:  index <= used
+// Post: entry has been inserted at position index and is now the current
+//       item.
+void rope_sequence::insert_at(size_type index, const value_type &entry) {
+  // Copied first: entry may refer into a leaf (through operator[]), and
+  // split_leaf may move it.
+  value_type item = entry;
+  leaf_node *leaf;
+  size_type offset;
+  locate(index, leaf, offset);
+  if (leaf->count == LEAF_CAPACITY) {
+    split_leaf(leaf);
+    if (offset > leaf->count) {
+      offset -= leaf->count;
+      leaf = leaf->next;
+    }
+  }
+
+  for (size_type i = leaf->count; i > offset; --i)
+    leaf->items[i] = leaf->items[i - 1];
+  leaf->items[offset] = item;
+  for (node *n = leaf; n != 0; n = n->parent)
+    ++n->count;
+  ++used;
+
+  current_index = index;
+  current_leaf = leaf;
+  current_offset = offset;
+}
+
+// Pre:  leaf is full
+// Post: The upper half of leaf's items have been moved into a new leaf
+//       that follows leaf (in the tree and in the leaf list).
+void rope_sequence::split_leaf(leaf_node *leaf) {
+  leaf_node *right = new_leaf();
+  size_type keep = leaf->count / 2;
+  right->count = leaf->count - keep;
+  for (size_type i = 0; i < right->count; ++i)
+    right->items[i] = leaf->items[keep + i];
+
+  right->prev = leaf;
+  right->next = leaf->next;
+  if (leaf->next != 0)
+    leaf->next->prev = right;
+  else
+    last = right;
+  leaf->next = right;
+
+  insert_after(leaf, right);
+  leaf->count = keep;
+}
+
+// Pre:  inner has FANOUT children
+// Post: The upper half of inner's children have been moved into a new
+//       inner node that follows inner in the tree.
+void rope_sequence::split_inner(inner_node *inner) {
+  inner_node *right = new inner_node;
+  size_type keep = inner->n_children / 2;
+  right->is_leaf = false;
+  right->count = 0;
+  right->n_children = inner->n_children - keep;
+  for (size_type i = 0; i < right->n_children; ++i) {
+    right->children[i] = inner->children[keep + i];
+    right->children[i]->parent = right;
+    right->count += right->children[i]->count;
+  }
+  inner->n_children = keep;
+
+  insert_after(inner, right);
+  inner->count -= right->count;
+}
+
+// Pre:  right is a new node whose items were split off from left, but
+//       are still counted in left->count (so the counts of left and its
+//       ancestors still add up while ancestors are split)
+// Post: right has been linked into the tree just after left, splitting
+//       ancestors (or adding a new root) as needed; the caller must then
+//       take right->count off left->count.
+void rope_sequence::insert_after(node *left, node *right) {
+  if (left->parent == 0) {
+    inner_node *new_root = new inner_node;
+    new_root->parent = 0;
+    new_root->is_leaf = false;
+    new_root->count = left->count;
+    new_root->n_children = 2;
+    new_root->children[0] = left;
+    new_root->children[1] = right;
+    left->parent = right->parent = new_root;
+    root = new_root;
+    return;
+  }
+
+  inner_node *parent = static_cast<inner_node *>(left->parent);
+  if (parent->n_children == FANOUT) {
+    // left (and so right) may end up under the new sibling.
+    split_inner(parent);
+    parent = static_cast<inner_node *>(left->parent);
+  }
+  size_type pos = index_in_parent(left) + 1;
+  for (size_type i = parent->n_children; i > pos; --i)
+    parent->children[i] = parent->children[i - 1];
+  parent->children[pos] = right;
+  ++parent->n_children;
+  right->parent = parent;
+}
+
+// Pre:  child is one of parent's children and holds no items that are
+//       still counted in parent
+// Post: child has been removed from parent's children (it is not
+//       deleted).
+void rope_sequence::remove_child(inner_node *parent, node *child) {
+  for (size_type i = index_in_parent(child) + 1; i < parent->n_children; ++i)
+    parent->children[i - 1] = parent->children[i];
+  --parent->n_children;
+}
+
+// Pre:  start_node may have too few items or children (invariant 6) or
+//       be an empty non-root node
+// Post: Empty nodes have been removed, sparse nodes merged with a
+//       sibling where possible (repeating up the tree as parents lose
+//       children), and a root with a single child replaced by that child
+//       (an empty tree is reset to a single empty leaf).
+void rope_sequence::rebalance(node *start_node) {
+  node *n = start_node;
+  while (n->parent != 0) {
+    inner_node *parent = static_cast<inner_node *>(n->parent);
+    size_type n_size =
+        n->is_leaf ? n->count : static_cast<inner_node *>(n)->n_children;
+
+    if (n_size == 0) {
+      if (n->is_leaf) {
+        leaf_node *leaf = static_cast<leaf_node *>(n);
+        (leaf->prev != 0 ? leaf->prev->next : first) = leaf->next;
+        (leaf->next != 0 ? leaf->next->prev : last) = leaf->prev;
+      }
+      remove_child(parent, n);
+      destroy(n);
+    } else if (n->is_leaf ? n_size < LEAF_CAPACITY / 4
+                          : n_size < FANOUT / 4) {
+      // An only child can't be merged, but its parent may be.
+      size_type i = index_in_parent(n);
+      if (parent->n_children == 1) {
+        n = parent;
+        continue;
+      }
+      node *left = (i + 1 < parent->n_children) ? n : parent->children[i - 1];
+      node *right = parent->children[index_in_parent(left) + 1];
+
+      if (n->is_leaf) {
+        leaf_node *l = static_cast<leaf_node *>(left);
+        leaf_node *r = static_cast<leaf_node *>(right);
+        if (l->count + r->count > LEAF_CAPACITY)
+          break;
+        for (size_type k = 0; k < r->count; ++k)
+          l->items[l->count + k] = r->items[k];
+        l->next = r->next;
+        (r->next != 0 ? r->next->prev : last) = l;
+      } else {
+        inner_node *l = static_cast<inner_node *>(left);
+        inner_node *r = static_cast<inner_node *>(right);
+        if (l->n_children + r->n_children > FANOUT)
+          break;
+        for (size_type k = 0; k < r->n_children; ++k) {
+          l->children[l->n_children + k] = r->children[k];
+          r->children[k]->parent = l;
+        }
+        l->n_children += r->n_children;
+        r->n_children = 0;
+      }
+      left->count += right->count;
+      remove_child(parent, right);
+      destroy(right);
+    } else {
+      break;
+    }
+    n = parent;
+  }
+
+  // Removing the last item can leave an inner root with no children.
+  if (!root->is_leaf && static_cast<inner_node *>(root)->n_children == 0) {
+    leaf_node *empty = new_leaf();
+    destroy(root);
+    root = first = last = empty;
+  }
+  // A root with a single child adds a level for nothing.
+  while (!root->is_leaf && static_cast<inner_node *>(root)->n_children == 1) {
+    inner_node *old_root = static_cast<inner_node *>(root);
+    root = old_root->children[0];
+    root->parent = 0;
+    old_root->n_children = 0;
+    destroy(old_root);
+  }
+}
+
+// Pre:  (none)
+// Post: root, first and last describe a new, tightly packed tree holding
+//       a copy of source's items (the old tree is left as is). If an
+//       allocation fails, nothing has changed.
+void rope_sequence::copy_items(const rope_sequence &source) {
+  size_type n_leaves = (source.used + LEAF_CAPACITY - 1) / LEAF_CAPACITY;
+  if (n_leaves == 0)
+    n_leaves = 1;
+  vector<node *> level;
+  level.reserve(n_leaves);
+  node_stock stock(n_leaves, inner_nodes_for(n_leaves));
+
+  leaf_node *leaf = 0;
+  for (leaf_node *s = source.first; s != 0; s = s->next) {
+    for (size_type i = 0; i < s->count; ++i) {
+      if (leaf == 0 || leaf->count == LEAF_CAPACITY) {
+        leaf_node *next = stock.take_leaf();
+        next->prev = leaf;
+        if (leaf != 0)
+          leaf->next = next;
+        leaf = next;
+        level.push_back(leaf);
+      }
+      leaf->items[leaf->count++] = s->items[i];
+    }
+  }
+  if (leaf == 0) {
+    leaf = stock.take_leaf();
+    level.push_back(leaf);
+  }
+  first = static_cast<leaf_node *>(level.front());
+  last = leaf;
+  build_levels(level, stock);
+}
+
+// Pre:  leaves holds the leaves to keep, in order (some may be empty),
+//       and has room for one more; the inner nodes above them have been
+//       deleted (or never existed). stock holds the inner nodes for a
+//       tree over leaves.size() leaves, and a leaf if none of them holds
+//       an item.
+// Post: Empty leaves have been deleted, and a leaf under a quarter full
+//       merged into the one before it if both fit in one leaf (so
+//       invariant 6 holds where leaves were cut or joined). The rest
+//       have been linked in order and a tree built over them (over an
+//       empty leaf from stock if there were none), which root, first and
+//       last now describe; leaves is used up in the process. The leaves'
+//       items are not copied otherwise, and nothing is allocated.
+void rope_sequence::relink(vector<node *> &leaves, node_stock &stock) {
+  size_type kept = 0;
+  for (size_type i = 0; i < leaves.size(); ++i) {
+    leaf_node *leaf = static_cast<leaf_node *>(leaves[i]);
+    leaf_node *prev =
+        kept > 0 ? static_cast<leaf_node *>(leaves[kept - 1]) : 0;
+    if (leaf->count == 0) {
+      delete leaf;
+    } else if (prev != 0 &&
+               (prev->count < LEAF_CAPACITY / 4 ||
+                leaf->count < LEAF_CAPACITY / 4) &&
+               prev->count + leaf->count <= LEAF_CAPACITY) {
+      for (size_type k = 0; k < leaf->count; ++k)
+        prev->items[prev->count + k] = leaf->items[k];
+      prev->count += leaf->count;
+      delete leaf;
+    } else {
+      leaves[kept++] = leaf;
+    }
+  }
+  leaves.resize(kept);
+  if (kept == 0)
+    leaves.push_back(stock.take_leaf());
+
+  for (size_type i = 0; i < leaves.size(); ++i) {
+    leaf_node *leaf = static_cast<leaf_node *>(leaves[i]);
+    leaf->prev = i > 0 ? static_cast<leaf_node *>(leaves[i - 1]) : 0;
+    leaf->next =
+        i + 1 < leaves.size() ? static_cast<leaf_node *>(leaves[i + 1]) : 0;
+  }
+  first = static_cast<leaf_node *>(leaves.front());
+  last = static_cast<leaf_node *>(leaves.back());
+  build_levels(leaves, stock);
+}
+
+// Pre:  level holds at least one node, in order, none of them with a
+//       parent yet, and stock holds inner_nodes_for(level.size()) inner
+//       nodes (or more).
+// Post: A tree has been built over the nodes of level, packed FANOUT to
+//       an inner node taken from stock, and root points to it; level is
+//       used up in the process. Nothing is allocated.
+void rope_sequence::build_levels(vector<node *> &level, node_stock &stock) {
+  // Build the inner levels bottom-up, FANOUT children at a time. Each
+  // level overwrites the front of the one below, which has been read by
+  // then.
+  while (level.size() > 1) {
+    size_type n_upper = 0;
+    for (size_type i = 0; i < level.size(); i += FANOUT) {
+      inner_node *inner = stock.take_inner();
+      inner->is_leaf = false;
+      inner->count = 0;
+      inner->n_children = 0;
+      for (size_type k = i; k < level.size() && k < i + FANOUT; ++k) {
+        inner->children[inner->n_children++] = level[k];
+        level[k]->parent = inner;
+        inner->count += level[k]->count;
+      }
+      level[n_upper++] = inner;
+    }
+    level.resize(n_upper);
+  }
+  root = level.front();
+  root->parent = 0;
+}
+
+// Pre:  (none)
+// Post: The return value is the number of leaves in the tree.
+rope_sequence::size_type rope_sequence::count_leaves() const {
+  size_type n = 0;
+  for (const leaf_node *leaf = first; leaf != 0; leaf = leaf->next)
+    ++n;
+  return n;
+}
+
+// Pre:  (none)
+// Post: The return value is the number of inner nodes that build_levels
+//       needs for a tree over n_leaves leaves.
+rope_sequence::size_type rope_sequence::inner_nodes_for(size_type n_leaves) {
+  size_type n_inners = 0;
+  for (size_type n = n_leaves; n > 1; n = (n + FANOUT - 1) / FANOUT)
+    n_inners += (n + FANOUT - 1) / FANOUT;
+  return n_inners;
+}
+
+// Pre:  0 < offset < leaf->count, and right is a new, empty leaf.
+// Post: leaf's items from items[offset] on have been moved into right,
+//       which has been linked into the leaf list after leaf and
+//       returned. The tree is not updated (its counts are left stale),
+//       so the caller must rebuild it (see relink).
+rope_sequence::leaf_node *
+rope_sequence::cut_leaf(leaf_node *leaf, size_type offset, leaf_node *right) {
+  right->count = leaf->count - offset;
+  for (size_type i = 0; i < right->count; ++i)
+    right->items[i] = leaf->items[offset + i];
+  leaf->count = offset;
+
+  right->prev = leaf;
+  right->next = leaf->next;
+  if (leaf->next != 0)
+    leaf->next->prev = right;
+  leaf->next = right;
+  return right;
+}
+
+// Pre:  (none)
+// Post: A new, empty, unlinked leaf has been returned.
+rope_sequence::leaf_node *rope_sequence::new_leaf() {
+  leaf_node *leaf = new leaf_node;
+  leaf->parent = 0;
+  leaf->count = 0;
+  leaf->is_leaf = true;
+  leaf->prev = leaf->next = 0;
+  return leaf;
+}
+
+// Pre:  (none)
+// Post: All nodes of subtree have been deleted.
+void rope_sequence::destroy(node *subtree) {
+  if (!subtree->is_leaf) {
+    inner_node *inner = static_cast<inner_node *>(subtree);
+    for (size_type i = 0; i < inner->n_children; ++i)
+      destroy(inner->children[i]);
+    delete inner;
+  } else {
+    delete static_cast<leaf_node *>(subtree);
+  }
+}
+
+// Pre:  (none)
+// Post: The inner nodes of subtree have been deleted, but not its leaves.
+void rope_sequence::destroy_inner(node *subtree) {
+  if (!subtree->is_leaf) {
+    inner_node *inner = static_cast<inner_node *>(subtree);
+    for (size_type i = 0; i < inner->n_children; ++i)
+      destroy_inner(inner->children[i]);
+    delete inner;
+  }
+}
+
+// NODE STOCK
+// Pre:  (none)
+// Post: The stock holds n_leaves new, empty leaves and n_inners new inner
+//       nodes. If an allocation fails, those already made are deleted.
+rope_sequence::node_stock::node_stock(size_type n_leaves,
+                                      size_type n_inners) {
+  leaves.reserve(n_leaves);
+  inners.reserve(n_inners);
+  try {
+    while (leaves.size() < n_leaves)
+      leaves.push_back(new_leaf());
+    while (inners.size() < n_inners)
+      inners.push_back(new inner_node);
+  } catch (...) {
+    clear();
+    throw;
+  }
+}
+
+rope_sequence::node_stock::~node_stock() { clear(); }
+
+// Pre:  The stock holds a leaf.
+// Post: A new, empty, unlinked leaf has been removed from the stock and
+//       returned.
+rope_sequence::leaf_node *rope_sequence::node_stock::take_leaf() {
+  assert(!leaves.empty());
+  leaf_node *leaf = leaves.back();
+  leaves.pop_back();
+  return leaf;
+}
+
+// Pre:  The stock holds an inner node.
+// Post: A new inner node (none of its members set) has been removed from
+//       the stock and returned.
+rope_sequence::inner_node *rope_sequence::node_stock::take_inner() {
+  assert(!inners.empty());
+  inner_node *inner = inners.back();
+  inners.pop_back();
+  return inner;
+}
+
+// Pre:  (none)
+// Post: The nodes left in the stock have been deleted.
+void rope_sequence::node_stock::clear() {
+  for (size_type i = 0; i < leaves.size(); ++i)
+    delete leaves[i];
+  for (size_type i = 0; i < inners.size(); ++i)
+    delete inners[i];
+  leaves.clear();
+  inners.clear();
+}
+
+// Pre:  child->parent != 0
+// Post: The position of child among its parent's children is returned.
+rope_sequence::size_type rope_sequence::index_in_parent(const node *child) {
+  const inner_node *parent = static_cast<const inner_node *>(child->parent);
+  size_type i = 0;
+  while (parent->children[i] != child)
+    ++i;
+  return i;
+}
+} // namespace CS3358_SP2024
@@ -0,0 +1,195 @@
+// FILE: RopeSequence.h
+// CLASS PROVIDED: rope_sequence (part of the namespace CS3358_SP2024)
+//
+// rope_sequence provides the same interface (typedefs, constants,
+// constructors and member functions) as sequence (see Sequence.h), and
+// the same documentation applies; simply replace sequence with
+// rope_sequence. The differences are in the storage (and so the cost of
+// the operations) and in what capacity means:
+//
+//   The items are kept in fixed-size chunks (leaves) of LEAF_CAPACITY
+//   items each, chosen so that a leaf's items fill a whole number of
+//   cache lines. The leaves hang under a B-tree whose nodes record how
+//   many items their subtree holds, so the leaf holding the item at any
+//   position can be found in O(log n), and an edit only shifts items
+//   within one leaf (splitting or merging leaves as they fill up or
+//   empty out). insert, attach and remove_current are therefore
+//   O(log n). The leaves are also linked in order, so start is O(log n)
+//   and advance is O(1), scanning each leaf contiguously.
+//
+//   Storage grows and shrinks one leaf at a time, so there is no
+//   capacity to manage: initial_capacity (constructor) and new_capacity
+//   (resize) are accepted for compatibility with sequence, but have no
+//   effect.
+//
+//   operator[] is O(log n), since it has to find the item's leaf.
+//   rope_sequence::const_iterator walks the leaf list, so it is only
+//   bidirectional (not random-access), but ++ and -- are O(1).
+//
+//   split_at_cursor and splice (see Sequence.h) move whole leaves from
+//   one rope_sequence to the other rather than copying their items: at
+//   most the leaf holding the cursor is cut in two, and a leaf left
+//   under a quarter full at a seam is merged with its neighbour. The
+//   B-tree above the leaves is then rebuilt, which takes time
+//   proportional to the number of leaves (n / LEAF_CAPACITY), not the
+//   number of items.
+//
+// VALUE SEMANTICS for the rope_sequence class:
+//   Assignments and the copy constructor may be used with rope_sequence
+//   objects.
+
+#ifndef ROPE_SEQUENCE_H
+#define ROPE_SEQUENCE_H
+#include <cstddef>  // provides ptrdiff_t
+#include <cstdlib>  // provides size_t
+#include <iterator> // provides bidirectional_iterator_tag
+#include <vector>
+
+namespace CS3358_SP2024
+{
+   class rope_sequence
+   {
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef double value_type;
+      typedef std::size_t size_type;
+      static const size_type DEFAULT_CAPACITY = 30;
+      class const_iterator;
+      // CONSTRUCTORS and DESTRUCTOR
+      rope_sequence(size_type initial_capacity = DEFAULT_CAPACITY);
+      rope_sequence(const rope_sequence& source);
+      ~rope_sequence();
+      // MODIFICATION MEMBER FUNCTIONS
+      void resize(size_type new_capacity);
+      void start();
+      void advance();
+      void insert(const value_type& entry);
+      void attach(const value_type& entry);
+      void remove_current();
+      rope_sequence split_at_cursor();
+      void splice(rope_sequence& other);
+      rope_sequence& operator=(const rope_sequence& source);
+      // CONSTANT MEMBER FUNCTIONS
+      size_type size() const;
+      bool is_item() const;
+      value_type current() const;
+      const value_type& operator[](size_type index) const;
+      const_iterator begin() const;
+      const_iterator end() const;
+   private:
+      // Items per leaf (1KB of doubles, i.e. 16 64-byte cache lines)
+      // and children per inner node.
+      static const size_type LEAF_CAPACITY = 1024 / sizeof(value_type);
+      static const size_type FANOUT = 32;
+      struct node
+      {
+         node* parent;
+         size_type count;  // # of items in the subtree
+         bool is_leaf;
+      };
+      struct leaf_node : node
+      {
+         value_type items[LEAF_CAPACITY];
+         leaf_node* prev;
+         leaf_node* next;
+      };
+      struct inner_node : node
+      {
+         node* children[FANOUT];
+         size_type n_children;
+      };
+      // Nodes allocated ahead of building a tree (see relink), so that
+      // the building itself can't fail halfway; those not taken are
+      // deleted with the stock.
+      struct node_stock
+      {
+         std::vector<leaf_node*> leaves;
+         std::vector<inner_node*> inners;
+         node_stock(size_type n_leaves, size_type n_inners);
+         ~node_stock();
+         leaf_node* take_leaf();
+         inner_node* take_inner();
+         void clear();
+         node_stock(const node_stock&) = delete;
+         node_stock& operator=(const node_stock&) = delete;
+      };
+      node* root;
+      leaf_node* first;
+      leaf_node* last;
+      size_type used;
+      size_type current_index;
+      leaf_node* current_leaf;
+      size_type current_offset;
+      // HELPER MEMBER FUNCTIONS
+      void locate(size_type index, leaf_node*& leaf, size_type& offset) const;
+      void sync_current();
+      void insert_at(size_type index, const value_type& entry);
+      void split_leaf(leaf_node* leaf);
+      void split_inner(inner_node* inner);
+      void insert_after(node* left, node* right);
+      void remove_child(inner_node* parent, node* child);
+      void rebalance(node* start_node);
+      void copy_items(const rope_sequence& source);
+      void relink(std::vector<node*>& leaves, node_stock& stock);
+      void build_levels(std::vector<node*>& level, node_stock& stock);
+      size_type count_leaves() const;
+      static size_type inner_nodes_for(size_type n_leaves);
+      static leaf_node* cut_leaf(leaf_node* leaf, size_type offset,
+                                 leaf_node* right);
+      static leaf_node* new_leaf();
+      static void destroy(node* subtree);
+      static void destroy_inner(node* subtree);
+      static size_type index_in_parent(const node* child);
+   };
+
+   // An iterator is a (leaf, offset) pair, like current_leaf and
+   // current_offset; end() is the position just past the last item of
+   // the last leaf.
+   class rope_sequence::const_iterator
+   {
+   public:
+      typedef std::bidirectional_iterator_tag iterator_category;
+      typedef rope_sequence::value_type value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const value_type* pointer;
+      typedef const value_type& reference;
+      const_iterator() : leaf(0), offset(0) {}
+      reference operator*() const { return leaf->items[offset]; }
+      pointer operator->() const { return &leaf->items[offset]; }
+      const_iterator& operator++()
+      {
+         if (++offset == leaf->count && leaf->next != 0)
+         {
+            leaf = leaf->next;
+            offset = 0;
+         }
+         return *this;
+      }
+      const_iterator& operator--()
+      {
+         if (offset == 0)
+         {
+            leaf = leaf->prev;
+            offset = leaf->count;
+         }
+         --offset;
+         return *this;
+      }
+      const_iterator operator++(int)
+         { const_iterator old = *this; ++*this; return old; }
+      const_iterator operator--(int)
+         { const_iterator old = *this; --*this; return old; }
+      bool operator==(const const_iterator& other) const
+         { return leaf == other.leaf && offset == other.offset; }
+      bool operator!=(const const_iterator& other) const
+         { return !(*this == other); }
+   private:
+      friend class rope_sequence;
+      const_iterator(const leaf_node* l, size_type o)
+         : leaf(l), offset(o) {}
+      const leaf_node* leaf;
+      size_type offset;
+   };
+}
+
+#endif
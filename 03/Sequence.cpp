@@ -37,30 +37,371 @@
 //                postcondition for the function for both of the two
 //                possible scenarios (current item is and is not the
 //                last item in the sequence).
+//   5. In copy-on-write mode, the member variable refs points to a
+//      count of the sequences sharing the dynamic array data (all of
+//      which point to the same count); outside copy-on-write mode refs
+//      is 0 and data belongs to the invoking sequence alone. Whenever
+//      *refs > 1 the items in data must not be modified; the array (and
+//      the count) are deleted by the last sequence that releases them.
+//      The count is atomic, since sequences sharing an array may be
+//      used (and destroyed) by different threads: a sequence that finds
+//      *refs == 1 is the only one left with the array, and no other can
+//      get it back (only copying a sequence that has it shares it).
+//   6. A moved-from sequence has data == 0 and used == capacity == 0.
+//   7. data is allocated, grown and freed only through the storage
+//      helpers below (allocate, reallocate and deallocate), since for a
+//      trivially copyable value_type it comes from malloc rather than
+//      new[], and it may come from a memory_resource instead. Likewise
+//      refs is allocated and freed only with new_count and delete_count.
+//   8. The member variable resource is the memory_resource data and refs
+//      were allocated from, or 0 if they came from the default heap
+//      (malloc or new). Sequences that share data (invariant 5) use
+//      equal resources, and have the same capacity.
 
 #include "Sequence.h"
+#include <algorithm>   // provides sort, merge, copy, swap
+#include <atomic>      // provides atomic, memory_order_*
 #include <cassert>
-#include <iostream>
-using namespace std;
-
+#include <cstdint>     // provides uint64_t
+#include <cstdlib>     // provides malloc, realloc, free
+#include <cstring>     // provides memmove, memcpy
+#include <exception>   // provides exception_ptr
+#include <iostream>
+#include <memory>      // provides unique_ptr
+#include <new>         // provides bad_alloc, placement new
+#include <stdexcept>   // provides length_error
+#include <thread>
+#include <type_traits> // provides is_trivially_copyable, is_same
+#include <vector>
+using namespace std;
+
 namespace CS3358_SP2024 {
+namespace {
+// STORAGE HELPERS
+// Items of a trivially copyable value_type (such as double) are moved
+// with one memmove, and their array is grown with realloc, which can
+// extend a block in place (glibc uses mremap for large blocks, so even a
+// huge array grows without copying). Any other value_type falls back to
+// new[]/delete[] and element-by-element assignment.
+//
+// A sequence with a memory_resource r (r != 0) gets its array from
+// r->allocate instead, constructing the items in place if value_type
+// isn't trivially copyable (so that, as with new[], every element of the
+// array is always constructed). There is no realloc for a resource, so
+// growing always copies.
+typedef sequence::value_type value_type;
+typedef sequence::size_type size_type;
+typedef atomic<size_type> ref_count;
+typedef is_trivially_copyable<value_type> trivial;
+
+// Bytes for an array of n items (at least 1, so even an empty array is a
+// distinct block).
+inline size_t array_bytes(size_t n) {
+  return (n > 0 ? n : 1) * sizeof(value_type);
+}
+
+// Copies n items from src to dest; the two ranges may overlap.
+inline void move_items(value_type *dest, const value_type *src, size_t n,
+                       true_type) {
+  if (n > 0)
+    memmove(static_cast<void *>(dest), static_cast<const void *>(src),
+            n * sizeof(value_type));
+}
+
+inline void move_items(value_type *dest, const value_type *src, size_t n,
+                       false_type) {
+  if (dest < src)
+    for (size_t i = 0; i < n; ++i)
+      dest[i] = src[i];
+  else
+    for (size_t i = n; i > 0; --i)
+      dest[i - 1] = src[i - 1];
+}
+
+// Destroys the item at p (a template, since p->~value_type() would look
+// value_type up in the item's own class when that is a class type).
+template <typename T> inline void destroy_item(T *p) { p->~T(); }
+
+inline value_type *allocate(size_t n, memory_resource *r, true_type) {
+  if (r != 0)
+    return static_cast<value_type *>(
+        r->allocate(array_bytes(n), alignof(value_type)));
+  void *p = malloc(array_bytes(n));
+  if (p == 0)
+    throw bad_alloc();
+  return static_cast<value_type *>(p);
+}
+
+inline value_type *allocate(size_t n, memory_resource *r, false_type) {
+  if (r == 0)
+    return new value_type[n];
+  value_type *p = static_cast<value_type *>(
+      r->allocate(array_bytes(n), alignof(value_type)));
+  size_t i = 0;
+  try {
+    for (; i < n; ++i)
+      new (p + i) value_type();
+  } catch (...) {
+    while (i > 0)
+      destroy_item(p + --i);
+    r->deallocate(p, array_bytes(n), alignof(value_type));
+    throw;
+  }
+  return p;
+}
+
+inline void deallocate(value_type *p, size_t n, memory_resource *r,
+                       true_type) {
+  if (r == 0)
+    free(p);
+  else if (p != 0)
+    r->deallocate(p, array_bytes(n), alignof(value_type));
+}
+
+inline void deallocate(value_type *p, size_t n, memory_resource *r,
+                       false_type) {
+  if (r == 0) {
+    delete[] p;
+  } else if (p != 0) {
+    for (size_t i = n; i > 0; --i)
+      destroy_item(p + i - 1);
+    r->deallocate(p, array_bytes(n), alignof(value_type));
+  }
+}
+
+inline value_type *reallocate(value_type *p, size_t used, size_t old_n,
+                              size_t n, memory_resource *r, true_type) {
+  if (r != 0) {
+    value_type *q = allocate(n, r, true_type());
+    move_items(q, p, used, true_type());
+    deallocate(p, old_n, r, true_type());
+    return q;
+  }
+  void *q = realloc(static_cast<void *>(p), array_bytes(n));
+  if (q == 0)
+    throw bad_alloc();
+  return static_cast<value_type *>(q);
+}
+
+inline value_type *reallocate(value_type *p, size_t used, size_t old_n,
+                              size_t n, memory_resource *r, false_type) {
+  value_type *q = allocate(n, r, false_type());
+  move_items(q, p, used, false_type());
+  deallocate(p, old_n, r, false_type());
+  return q;
+}
+
+inline value_type *allocate(size_t n, memory_resource *r) {
+  return allocate(n, r, trivial());
+}
+
+inline void deallocate(value_type *p, size_t n, memory_resource *r) {
+  deallocate(p, n, r, trivial());
+}
+
+inline value_type *reallocate(value_type *p, size_t used, size_t old_n,
+                              size_t n, memory_resource *r) {
+  return reallocate(p, used, old_n, n, r, trivial());
+}
+
+inline void move_items(value_type *dest, const value_type *src, size_t n) {
+  move_items(dest, src, n, trivial());
+}
+
+// The copy-on-write count (see invariant 5) comes from the same place as
+// the array it counts.
+inline ref_count *new_count(memory_resource *r) {
+  if (r == 0)
+    return new ref_count(1);
+  return new (r->allocate(sizeof(ref_count), alignof(ref_count)))
+      ref_count(1);
+}
+
+inline void delete_count(ref_count *refs, memory_resource *r) {
+  if (r == 0)
+    delete refs;
+  else
+    r->deallocate(refs, sizeof(ref_count), alignof(ref_count));
+}
+
+// Adding a sharer needs no ordering: it's done by a thread that already
+// holds a reference. Dropping one publishes this thread's reads of the
+// items (release) to whichever thread ends up deleting or modifying them
+// (acquire).
+inline void add_ref(ref_count *refs) {
+  refs->fetch_add(1, memory_order_relaxed);
+}
+
+// Post: The return value is true if this was the last reference.
+inline bool drop_ref(ref_count *refs) {
+  return refs->fetch_sub(1, memory_order_acq_rel) == 1;
+}
+
+inline bool is_unique(const ref_count *refs) {
+  return refs->load(memory_order_acquire) == 1;
+}
+
+// True if memory allocated for a sequence using resource a may be freed
+// by one using resource b.
+inline bool same_resource(memory_resource *a, memory_resource *b) {
+  return a == b || (a != 0 && b != 0 && a->is_equal(*b));
+}
+
+// Capacity to grow a full array of the given capacity to: 1.5 times as
+// big (at least 8), so n inserts cost O(n) copying in total, and blocks
+// freed by earlier growth can be reused by later growth.
+inline size_t grown_capacity(size_t capacity) {
+  if (capacity < 8)
+    return 8;
+  if (capacity > size_t(-1) / 3 * 2)
+    throw length_error("sequence capacity overflow");
+  return capacity + capacity / 2;
+}
+
+// SORTING HELPERS
+// A sequence of double is radix sorted (see sort in Sequence.h); any
+// other value_type falls back to std::sort.
+typedef is_same<value_type, double> radix_sortable;
+
+// The bits of x as an unsigned key that orders doubles as < does (apart
+// from -0.0 and NaNs): setting the sign bit of a positive number puts it
+// above every negative one, and flipping all the bits of a negative
+// number reverses their order (the larger the magnitude, the smaller).
+inline uint64_t radix_key(double x) {
+  const uint64_t sign = uint64_t(1) << 63;
+  uint64_t bits;
+  memcpy(&bits, &x, sizeof(bits));
+  return (bits & sign) ? ~bits : (bits | sign);
+}
+
+// The order the items are sorted into (and merged by).
+inline bool item_less(const double &a, const double &b, true_type) {
+  return radix_key(a) < radix_key(b);
+}
+
+template <typename T>
+inline bool item_less(const T &a, const T &b, false_type) {
+  return a < b;
+}
+
+// Pre:  a and scratch each point to n items.
+// Post: a[0] through a[n-1] are in order of radix_key (stably), and
+//       scratch has been overwritten. One pass counts all 8 bytes of
+//       every key; then each byte, from the lowest, is a counting sort
+//       from one array to the other. Few items are insertion sorted
+//       instead, as clearing and summing the counts would cost more.
+template <typename T>
+void sort_items(T *a, T *scratch, size_t n, true_type) {
+  if (n < 64) {
+    for (size_t i = 1; i < n; ++i) {
+      T item = a[i];
+      uint64_t key = radix_key(item);
+      size_t j = i;
+      for (; j > 0 && radix_key(a[j - 1]) > key; --j)
+        a[j] = a[j - 1];
+      a[j] = item;
+    }
+    return;
+  }
+
+  size_t counts[8][256] = {};
+  for (size_t i = 0; i < n; ++i) {
+    uint64_t key = radix_key(a[i]);
+    for (int b = 0; b < 8; ++b)
+      ++counts[b][(key >> (8 * b)) & 0xff];
+  }
+
+  T *src = a, *dest = scratch;
+  for (int b = 0; b < 8; ++b) {
+    size_t *next = counts[b];
+    // A byte that is the same in every key (such as the top bytes of
+    // items of similar size) leaves the order as it is.
+    if (next[(radix_key(src[0]) >> (8 * b)) & 0xff] == n)
+      continue;
+    size_t total = 0;
+    for (int d = 0; d < 256; ++d) {
+      size_t count = next[d];
+      next[d] = total;
+      total += count;
+    }
+    for (size_t i = 0; i < n; ++i) {
+      T item = src[i];
+      dest[next[(radix_key(item) >> (8 * b)) & 0xff]++] = item;
+    }
+    std::swap(src, dest);
+  }
+  if (src != a)
+    memcpy(a, src, n * sizeof(T));
+}
+
+template <typename T> void sort_items(T *a, T *, size_t n, false_type) {
+  std::sort(a, a + n);
+}
+
+// Runs task(0) through task(count-1) at the same time, task(0) in this
+// thread and each of the others in a thread of its own (or in this
+// thread too, if no more threads can be started), and waits for all of
+// them. The first exception thrown by a task is rethrown once they have
+// all finished.
+template <typename Task> void run_parallel(size_t count, Task task) {
+  vector<exception_ptr> errors(count);
+  auto run = [&](size_t i) {
+    try {
+      task(i);
+    } catch (...) {
+      errors[i] = current_exception();
+    }
+  };
+  vector<thread> threads;
+  threads.reserve(count);
+  for (size_t i = 1; i < count; ++i) {
+    try {
+      threads.emplace_back(run, i);
+    } catch (const system_error &) {
+      run(i);
+    }
+  }
+  run(0);
+  for (size_t i = 0; i < threads.size(); ++i)
+    threads[i].join();
+  for (size_t i = 0; i < count; ++i)
+    if (errors[i])
+      rethrow_exception(errors[i]);
+}
+} // namespace
+
 // CONSTRUCTORS and DESTRUCTOR
-sequence::sequence(size_type initial_capacity)
-    : used(0), current_index(0), capacity(initial_capacity) {
+sequence::sequence(size_type initial_capacity, memory_resource *resource)
+    : used(0), current_index(0), capacity(initial_capacity), refs(0),
+      resource(resource) {
   if (initial_capacity <= 0)
     capacity = DEFAULT_CAPACITY;
-  data = new value_type[capacity];
+  data = allocate(capacity, resource);
 }
 
 sequence::sequence(const sequence &source)
     : used(source.used), current_index(source.current_index),
-      capacity(source.capacity) {
-  data = new value_type[capacity];
-  for (size_type i = 0; i < used; i++)
-    data[i] = source.data[i];
+      capacity(source.capacity), refs(source.refs),
+      resource(source.resource) {
+  if (refs != 0) {
+    data = source.data;
+    add_ref(refs);
+  } else {
+    data = allocate(capacity, resource);
+    move_items(data, source.data, used);
+  }
 }
 
-sequence::~sequence() { delete[] data; }
+sequence::sequence(sequence &&source) noexcept
+    : data(source.data), used(source.used),
+      current_index(source.current_index), capacity(source.capacity),
+      refs(source.refs), resource(source.resource) {
+  source.data = 0;
+  source.used = source.current_index = source.capacity = 0;
+  source.refs = 0;
+}
+
+sequence::~sequence() { release(); }
 
 // MODIFICATION MEMBER FUNCTIONS
 void sequence::resize(size_type new_capacity) {
@@ -69,14 +410,22 @@ void sequence::resize(size_type new_capacity) {
   if (new_capacity < used)
     new_capacity = used;
 
-  value_type *temp = new value_type[new_capacity];
-  for (size_type i = 0; i < used; ++i)
-    temp[i] = data[i];
-  delete[] data;
-  data = temp;
+  if (refs == 0 || is_unique(refs)) {
+    data = reallocate(data, used, capacity, new_capacity, resource);
+  } else {
+    // Shared (copy-on-write): the others keep the old array.
+    value_type *temp = allocate(new_capacity, resource);
+    move_items(temp, data, used);
+    ref_count *temp_refs = new_count(resource);
+    release();
+    data = temp;
+    refs = temp_refs;
+  }
   capacity = new_capacity;
 }
 
+void sequence::shrink_to_fit() { resize(used); }
+
 void sequence::start() { current_index = 0; }
 
 void sequence::advance() {
@@ -85,54 +434,267 @@ void sequence::advance() {
 }
 
 void sequence::insert(const value_type &entry) {
-  if (size() >= capacity)
-    resize(capacity * 1.5 + 1);
-
+  // Copied first: entry may refer into data (through operator[]), which
+  // make_gap may move.
+  value_type item = entry;
   if (!is_item())
     current_index = 0;
-  for (size_type i = used; i > current_index; --i)
-    data[i] = data[i - 1];
-  data[current_index] = entry;
-  ++used;
+  make_gap(current_index, 1);
+  data[current_index] = item;
 }
 
 void sequence::attach(const value_type &entry) {
-  if (size() >= capacity)
-    resize(capacity * 1.5 + 1);
-
+  value_type item = entry; // see insert
   if (!is_item())
     current_index = used;
   else
     ++current_index;
 
-  for (size_type i = used; i > current_index; --i)
-    data[i] = data[i - 1];
-  data[current_index] = entry;
-  ++used;
+  make_gap(current_index, 1);
+  data[current_index] = item;
 }
 
 void sequence::remove_current() {
   if (is_item()) {
-    for (size_type i = current_index; i < used - 1; ++i)
-      data[i] = data[i + 1];
+    unshare();
+    move_items(data + current_index, data + current_index + 1,
+               used - current_index - 1);
     --used;
+    shrink_if_sparse();
+  }
+}
+
+void sequence::insert_range(const value_type items[], size_type count) {
+  if (count == 0)
+    return;
+  if (!is_item())
+    current_index = 0;
+  make_gap(current_index, count);
+  move_items(data + current_index, items, count);
+}
+
+void sequence::attach_range(const value_type items[], size_type count) {
+  if (count == 0)
+    return;
+  size_type first = is_item() ? current_index + 1 : used;
+  make_gap(first, count);
+  move_items(data + first, items, count);
+  current_index = first + count - 1;
+}
+
+void sequence::erase_range(size_type count) {
+  if (is_item()) {
+    if (count > used - current_index)
+      count = used - current_index;
+    unshare();
+    move_items(data + current_index, data + current_index + count,
+               used - current_index - count);
+    used -= count;
+    shrink_if_sparse();
+  }
+}
+
+sequence sequence::split_at_cursor() {
+  size_type count = used - current_index;
+  // (If all the items go, tail only needs an array to give back.)
+  sequence tail(count < used ? count : DEFAULT_CAPACITY, resource);
+  if (refs != 0)
+    tail.copy_on_write(true);
+  if (count == 0)
+    return tail;
+
+  if (count == used) {
+    // Everything goes: hand over the whole array (taking tail's empty
+    // one, already in the same copy-on-write mode).
+    tail.swap(*this);
+  } else {
+    move_items(tail.data, data + current_index, count);
+    tail.used = count;
+    // The items kept stay where they are, so a shared array needn't be
+    // copied (shrinking it may still copy them, to a smaller array).
+    used = current_index;
+    shrink_if_sparse();
+  }
+  return tail;
+}
+
+void sequence::splice(sequence &other) {
+  assert(&other != this);
+  if (other.used == 0)
+    return;
+  if (used == 0 && same_resource(resource, other.resource) &&
+      (refs == 0) == (other.refs == 0)) {
+    // Take over other's array, leaving it ours (which is empty).
+    swap(other);
+    current_index = used;
+    return;
+  }
+
+  size_type index = current_index;
+  make_gap(index, other.used);
+  move_items(data + index, other.data, other.used);
+  current_index += other.used;
+  // other's items were only read, so its array may stay shared until it
+  // is shrunk.
+  other.used = other.current_index = 0;
+  other.shrink_if_sparse();
+}
+
+void sequence::seek_lower_bound(const value_type &target) {
+  // Invariant: items before low are less than target, and items from
+  // high on are not.
+  size_type low = 0, high = used;
+  while (low < high) {
+    size_type mid = low + (high - low) / 2;
+    if (data[mid] < target)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  current_index = low;
+}
+
+void sequence::insert_sorted(const value_type &entry) {
+  value_type item = entry; // see insert
+  // As in seek_lower_bound, but stopping after items equal to item.
+  size_type low = 0, high = used;
+  while (low < high) {
+    size_type mid = low + (high - low) / 2;
+    if (item < data[mid])
+      high = mid;
+    else
+      low = mid + 1;
+  }
+  current_index = low;
+  make_gap(current_index, 1);
+  data[current_index] = item;
+}
+
+void sequence::sort() {
+  if (used > 1) {
+    unshare();
+    unique_ptr<value_type[]> scratch(
+        radix_sortable::value ? new value_type[used] : 0);
+    sort_items(data, scratch.get(), used, radix_sortable());
+  }
+  current_index = 0;
+}
+
+void sequence::parallel_sort(unsigned threads) {
+  if (threads == 0)
+    threads = thread::hardware_concurrency();
+  size_type parts = 1;
+  while (parts * 2 <= threads)
+    parts *= 2;
+  if (used < PARALLEL_SORT_THRESHOLD || parts < 2) {
+    sort();
+    return;
+  }
+
+  unshare();
+  unique_ptr<value_type[]> scratch(new value_type[used]);
+  vector<size_type> bounds(parts + 1);
+  for (size_type i = 0; i < parts; ++i)
+    bounds[i] = used / parts * i;
+  bounds[parts] = used;
+
+  value_type *items = data, *temp = scratch.get();
+  run_parallel(parts, [&](size_type i) {
+    sort_items(items + bounds[i], temp + bounds[i], bounds[i + 1] - bounds[i],
+               radix_sortable());
+  });
+  // Merge the sorted parts in pairs, back and forth between data and
+  // scratch, halving the number of parts (and threads) each round.
+  for (size_type width = 1; width < parts; width *= 2) {
+    run_parallel(parts / (2 * width), [&](size_type i) {
+      size_type low = bounds[2 * width * i];
+      size_type middle = bounds[2 * width * i + width];
+      size_type high = bounds[2 * width * (i + 1)];
+      merge(items + low, items + middle, items + middle, items + high,
+            temp + low, [](const value_type &a, const value_type &b) {
+              return item_less(a, b, radix_sortable());
+            });
+    });
+    std::swap(items, temp);
   }
+  if (items != data)
+    copy(items, items + used, data);
+  current_index = 0;
 }
 
 sequence &sequence::operator=(const sequence &source) {
   if (this != &source) {
-    value_type *temp = new value_type[source.capacity];
-    for (size_type i = 0; i < source.used; ++i)
-      temp[i] = source.data[i];
-    delete[] data;
-    data = temp;
+    // The invoking sequence keeps its own resource, so it can share
+    // source's array only if that came from an equal resource.
+    if (source.refs != 0 && same_resource(resource, source.resource)) {
+      // Take the count first in case source already shares our array.
+      add_ref(source.refs);
+      release();
+      data = source.data;
+      refs = source.refs;
+    } else {
+      value_type *temp = allocate(source.capacity, resource);
+      move_items(temp, source.data, source.used);
+      release();
+      data = temp;
+      refs = 0;
+    }
+    used = source.used;
+    current_index = source.current_index;
+    capacity = source.capacity;
+    if (source.refs != 0)
+      copy_on_write(true);
+  }
+  return *this;
+}
+
+sequence &sequence::operator=(sequence &&source) noexcept {
+  if (this != &source) {
+    release();
+    data = source.data;
     used = source.used;
     current_index = source.current_index;
     capacity = source.capacity;
+    refs = source.refs;
+    resource = source.resource;
+    source.data = 0;
+    source.used = source.current_index = source.capacity = 0;
+    source.refs = 0;
   }
   return *this;
 }
 
+void sequence::swap(sequence &other) noexcept {
+  value_type *temp_data = data;
+  data = other.data;
+  other.data = temp_data;
+  size_type temp = used;
+  used = other.used;
+  other.used = temp;
+  temp = current_index;
+  current_index = other.current_index;
+  other.current_index = temp;
+  temp = capacity;
+  capacity = other.capacity;
+  other.capacity = temp;
+  ref_count *temp_refs = refs;
+  refs = other.refs;
+  other.refs = temp_refs;
+  memory_resource *temp_resource = resource;
+  resource = other.resource;
+  other.resource = temp_resource;
+}
+
+void sequence::copy_on_write(bool enable) {
+  if (enable && refs == 0) {
+    refs = new_count(resource);
+  } else if (!enable && refs != 0) {
+    unshare();
+    delete_count(refs, resource);
+    refs = 0;
+  }
+}
+
 // CONSTANT MEMBER FUNCTIONS
 sequence::size_type sequence::size() const { return used; }
 
@@ -144,6 +706,96 @@ sequence::value_type sequence::current() const {
   }
   return data[current_index];
 }
+
+bool sequence::is_copy_on_write() const { return refs != 0; }
+
+memory_resource *sequence::get_resource() const { return resource; }
+
+const sequence::value_type &sequence::operator[](size_type index) const {
+  assert(index < used);
+  return data[index];
+}
+
+sequence::const_iterator sequence::begin() const { return data; }
+
+sequence::const_iterator sequence::end() const { return data + used; }
+
+sequence::const_slice sequence::slice(size_type begin, size_type end) const {
+  assert(begin <= end && end <= used);
+  return const_slice(data + begin, end - begin);
+}
+
+// HELPER MEMBER FUNCTIONS
+// Pre:  (none)
+// Post: The invoking sequence no longer references data (or refs); the
+//       array (and count) have been deleted if no other sequence shares
+//       them. data and refs are left dangling for the caller to reset.
+void sequence::release() {
+  if (refs == 0) {
+    deallocate(data, capacity, resource);
+  } else if (drop_ref(refs)) {
+    deallocate(data, capacity, resource);
+    delete_count(refs, resource);
+  }
+}
+
+// Pre:  (none)
+// Post: data is no longer shared with any other sequence (the items have
+//       been copied into a new array of the same capacity if they were),
+//       so it may be modified.
+void sequence::unshare() {
+  if (refs != 0 && !is_unique(refs)) {
+    value_type *temp = allocate(capacity, resource);
+    move_items(temp, data, used);
+    ref_count *temp_refs = new_count(resource);
+    // The others may all let go of the old array meanwhile, so it is
+    // released (not just uncounted) in case this was the last reference.
+    release();
+    data = temp;
+    refs = temp_refs;
+  }
+}
+
+// Pre:  (none)
+// Post: If fewer than a quarter of capacity items are used, capacity has
+//       been halved (repeatedly, until a quarter or more are used, but
+//       not below DEFAULT_CAPACITY). The hysteresis keeps alternating
+//       inserts and removes from reallocating over and over: shrinking
+//       leaves the array about half full, and growing (make_gap) two
+//       thirds full, so either takes many more changes before it's
+//       reallocated again. If a smaller array can't be allocated, the
+//       old one is simply kept.
+void sequence::shrink_if_sparse() {
+  size_type new_capacity = capacity;
+  while (used < new_capacity / 4 && new_capacity / 2 >= DEFAULT_CAPACITY)
+    new_capacity /= 2;
+  if (new_capacity == capacity)
+    return;
+  try {
+    resize(new_capacity);
+  } catch (const bad_alloc &) {
+  }
+}
+
+// Pre:  index <= used
+// Post: data is unshared with room for used + count items, the items
+//       from data[index] on have been moved count places up (leaving
+//       data[index] through data[index+count-1] for the caller to fill),
+//       and used has been increased by count.
+void sequence::make_gap(size_type index, size_type count) {
+  assert(index <= used);
+  if (used + count > capacity) {
+    size_type new_capacity = grown_capacity(capacity);
+    resize(new_capacity < used + count ? used + count : new_capacity);
+  } else {
+    unshare();
+  }
+  move_items(data + index + count, data + index, used - index);
+  used += count;
+}
+
+// NON-MEMBER FUNCTIONS
+void swap(sequence &s1, sequence &s2) noexcept { s1.swap(s2); }
 } // namespace CS3358_SP2024
 
 
@@ -16,13 +16,51 @@
 //    sequence::DEFAULT_CAPACITY is the default initial capacity of a
 //    sequence that is created by the default constructor.
 //
+//   static const size_type PARALLEL_SORT_THRESHOLD = _____
+//    sequence::PARALLEL_SORT_THRESHOLD is the fewest items for which
+//    parallel_sort uses more than one thread.
+//
+//   typedef ____ const_iterator
+//    sequence::const_iterator is a random-access iterator over the items
+//    of a sequence that can't be used to change them. Any number of
+//    iterators may traverse a sequence at once, independently of each
+//    other and of the sequence's current item.
+//
+//   class const_slice
+//    A sequence::const_slice is a read-only view of a run of consecutive
+//    items of a sequence (see slice). It doesn't own or copy the items:
+//    it just points at them where they are stored. Its members are
+//      size_type size() const           the number of items in view;
+//      const value_type& operator[](size_type index) const
+//                                       the item at position index of
+//                                       the view (index < size());
+//      const_iterator begin() const
+//      const_iterator end() const       iterators to the first item of
+//                                       the view and just past its last.
+//
 // CONSTRUCTOR for the sequence class:
-//   sequence(size_type initial_capacity = DEFAULT_CAPACITY)
-//    Pre:  initial_capacity > 0
+//   sequence(size_type initial_capacity = DEFAULT_CAPACITY,
+//            memory_resource* resource = 0)
+//    Pre:  initial_capacity > 0, and resource (if not 0) outlives the
+//      sequence.
 //    Post: The sequence has been initialized as an empty sequence.
 //      The insert/attach functions will work efficiently (without
-//      allocating new memory) until this capacity is reached.
+//      allocating new memory) until this capacity is reached. The
+//      sequence's storage will be allocated from resource (see
+//      MemoryResource.h), or from the heap if resource is 0.
 //    Note: If Pre is not met, initial_capacity will be adjusted to 1.
+//    Note: A copy of a sequence (copy constructor) uses the same
+//      resource as the original, and a sequence moved from another
+//      (move constructor, move assignment or swap) takes over the
+//      other's resource along with its storage. A sequence assigned to
+//      (copy assignment) keeps its own resource.
+//
+//   sequence(sequence&& source)
+//    Pre:  none
+//    Post: The sequence has been initialized with the items, current
+//      item and storage of source (no items are copied), and source
+//      has become an empty sequence with capacity 0 (it may still be
+//      used or assigned to).
 //
 // MODIFICATION MEMBER FUNCTIONS for the sequence class:
 //   void resize(size_type new_capacity)
@@ -34,6 +72,19 @@
 //    Note: If new_capacity is less than used, it will be made equal to
 //      to used (in order to preserve existing data). Thereafter, if Pre
 //      is not met, new_capacity will be adjusted to 1.
+//    Note: The capacity is also lowered automatically when items are
+//      removed (remove_current, erase_range or remove_if): whenever
+//      fewer than a quarter of it are in use after a removal, it is
+//      halved (as often as needed, but not below DEFAULT_CAPACITY).
+//      This leaves the sequence about half full, whereas growing leaves
+//      it two thirds full, so alternating inserts and removes never
+//      keep reallocating. A capacity reserved with resize may be given
+//      back this way.
+//
+//   void shrink_to_fit()
+//    Pre:  none
+//    Post: The sequence's capacity is now the number of items on it (or
+//      1 if it is empty), so no memory is held for items not there.
 //
 //   void start()
 //    Pre:  none
@@ -70,6 +121,147 @@
 //      item. If the current item was already the last item in the
 //      sequence, then there is no longer any current item.
 //
+//   void insert_range(const value_type items[], size_type count)
+//    Pre:  items points to at least count items (it may be 0 if count
+//      is 0) that are not stored in the invoking sequence.
+//    Post: Copies of items[0] through items[count-1] have been inserted,
+//      in that order, before the current item. If there was no current
+//      item, then they have been inserted at the front of the sequence.
+//      Unless count is 0, the copy of items[0] is now the current item.
+//    Note: The result is the same as calling insert for items[count-1],
+//      items[count-2], ..., items[0] (in that order), but the existing
+//      items are shifted only once.
+//
+//   void attach_range(const value_type items[], size_type count)
+//    Pre:  items points to at least count items (it may be 0 if count
+//      is 0) that are not stored in the invoking sequence.
+//    Post: Copies of items[0] through items[count-1] have been inserted,
+//      in that order, after the current item. If there was no current
+//      item, then they have been attached to the end of the sequence.
+//      Unless count is 0, the copy of items[count-1] is now the current
+//      item.
+//    Note: The result is the same as calling attach for items[0],
+//      items[1], ..., items[count-1] (in that order), but the existing
+//      items are shifted only once.
+//
+//   void erase_range(size_type count)
+//    Pre:  is_item returns true.
+//    Post: The current item and the count-1 items after it (or as many
+//      of them as there are) have been removed from the sequence, and
+//      the item after the last one removed (if there is one) is now the
+//      new current item; otherwise there is no longer any current item.
+//    Note: The result is the same as calling remove_current count times
+//      (or until there's no current item), but the remaining items are
+//      shifted only once.
+//
+//   sequence split_at_cursor()
+//    Pre:  none
+//    Post: The current item and all the items after it have been removed
+//      from the invoking sequence, which no longer has a current item,
+//      and are returned, in the same order, as a new sequence whose
+//      current item is its first item. If there was no current item,
+//      the invoking sequence is unchanged and the return value is an
+//      empty sequence. The new sequence uses the same resource as the
+//      invoking one, and is in copy-on-write mode if it is.
+//    Note: The items split off are copied to the new sequence's array
+//      in one block move, and the items kept are not touched (even if
+//      the array is shared), so this takes time proportional to the
+//      number of items split off. Splitting at the first item hands
+//      over the whole array instead, in O(1). The invoking sequence's
+//      capacity may then be lowered as for erase_range.
+//
+//   void splice(sequence& other)
+//    Pre:  other is not the invoking sequence.
+//    Post: All of other's items have been moved, in order, into the
+//      invoking sequence before its current item (or after its last
+//      item if there is no current item), and other is now empty. The
+//      current item is unchanged (the same item as before, or none).
+//    Note: If the invoking sequence is empty and other's storage comes
+//      from an equal resource, it takes over that storage (as a move
+//      would), in O(1). Otherwise the items after the current one are
+//      shifted up once to make room, and other's items are copied into
+//      the gap in one block move. If memory for that can't be
+//      allocated, neither sequence is changed.
+//
+//   void seek_lower_bound(const value_type& target)
+//    Pre:  The items are in non-decreasing order (from the first to the
+//      last item).
+//    Post: The first item that is not less than target (if there is
+//      one) is now the current item; otherwise there is no longer any
+//      current item. The items are unchanged.
+//    Note: Uses a binary search, so takes O(log n) time rather than the
+//      O(n) of a start/advance scan.
+//
+//   void insert_sorted(const value_type& entry)
+//    Pre:  The items are in non-decreasing order.
+//    Post: A new copy of entry has been inserted after the last item that
+//      is not greater than it (so after any items equal to it), keeping
+//      the items in non-decreasing order, and the newly inserted item is
+//      now the current item of the sequence.
+//    Note: The position is found by binary search; moving the later
+//      items up to make room still takes O(n) time.
+//
+//   void sort()
+//    Pre:  none
+//    Post: The items have been rearranged into non-decreasing order, and
+//      the first item (if there is one) is now the current item.
+//    Note: A sequence of double is sorted by an LSD radix sort of the
+//      items' bit patterns (O(n): 8 passes over the items, skipping any
+//      byte that is the same for all of them); -0.0 is put before 0.0,
+//      and NaNs at the ends (those with the sign bit set first, the
+//      rest last). Any other value_type is sorted with std::sort (an
+//      introsort, O(n log n)) using operator<. Either way a temporary
+//      array of size() items is used.
+//
+//   void parallel_sort(unsigned threads = 0)
+//    Pre:  none
+//    Post: As for sort.
+//    Note: If there are at least PARALLEL_SORT_THRESHOLD items, they are
+//      split into as many parts as threads (or the number of hardware
+//      threads if threads is 0), rounded down to a power of two; the
+//      parts are sorted at the same time, each by its own thread, and
+//      then merged (also in parallel, pairwise). With fewer items, or
+//      only one thread, this is just sort.
+//
+//   template <typename Predicate> size_type remove_if(Predicate pred)
+//    Pre:  pred can be called with a const value_type& and returns
+//      something convertible to bool, and doesn't change the sequence.
+//    Post: Every item for which pred returned true has been removed
+//      from the sequence, and the remaining items keep their order. The
+//      return value is the number of items removed. If the current item
+//      was kept, it is still the current item; if it was removed, the
+//      first remaining item after it (if there is one) is now the new
+//      current item, as for remove_current; otherwise there is no longer
+//      any current item.
+//    Note: pred is called once for each item, front to back. The
+//      remaining items are moved at most once each, so this is O(n),
+//      unlike calling remove_current for each item to be removed. If
+//      pred throws, the items may have been left partly rearranged.
+//
+//   void swap(sequence& other)
+//    Pre:  none
+//    Post: The invoking sequence and other have exchanged their items,
+//      current items and storage (no items are copied, and nothing can
+//      throw).
+//
+//   void copy_on_write(bool enable)
+//    Pre:  none
+//    Post: Copy-on-write mode is turned on (enable is true) or off for
+//      the invoking sequence. In copy-on-write mode, copies made from
+//      the sequence (with the copy constructor or assignment) share its
+//      storage instead of copying the items, and are themselves in
+//      copy-on-write mode; a sequence gets its own copy of the items
+//      only when it is first modified (resize, insert, attach or
+//      remove_current) while its storage is shared. Turning the mode
+//      off first gives the sequence its own copy of the items if they
+//      are shared.
+//    Note: Copy-on-write mode is off for a newly constructed sequence.
+//      Sequences that share storage may be used and destroyed by
+//      different threads (the count of sharers is atomic), as long as
+//      each sequence object is used by only one thread at a time and
+//      their resource may be used from several threads at once (as
+//      new_delete_resource may, but not a monotonic_arena).
+//
 // CONSTANT MEMBER FUNCTIONS for the sequence class:
 //   size_type size() const
 //    Pre:  none
@@ -86,13 +278,55 @@
 //    Pre:  is_item() returns true.
 //    Post: The item returned is the current item in the sequence.
 //
+//   bool is_copy_on_write() const
+//    Pre:  none
+//    Post: The return value is true if the sequence is in copy-on-write
+//      mode (see copy_on_write), otherwise false.
+//
+//   memory_resource* get_resource() const
+//    Pre:  none
+//    Post: The return value is the resource the sequence's storage is
+//      allocated from (0 for the heap).
+//
+//   const value_type& operator[](size_type index) const
+//    Pre:  index < size()
+//    Post: The item at position index (counting from 0 at the front of
+//      the sequence) is returned. The current item is unchanged.
+//
+//   const_iterator begin() const
+//   const_iterator end() const
+//    Pre:  none
+//    Post: An iterator to the first item of the sequence, or just past
+//      its last item, is returned (the two are equal for an empty
+//      sequence). The current item is unchanged.
+//    Note: References returned by operator[] and iterators returned by
+//      begin and end remain valid only until the sequence is next
+//      modified (resize, insert, attach, remove_current, the range
+//      functions, assignment, swap or copy_on_write), or destroyed.
+//
+//   const_slice slice(size_type begin, size_type end) const
+//    Pre:  begin <= end <= size()
+//    Post: The return value is a view of the items at positions begin
+//      through end-1 (empty if begin == end). The current item is
+//      unchanged.
+//    Note: O(1), since no items are copied; the view remains valid only
+//      as long as an iterator would (see above).
+//
+// NON-MEMBER FUNCTIONS for the sequence class:
+//   void swap(sequence& s1, sequence& s2)
+//    Pre:  none
+//    Post: Same as s1.swap(s2).
+//
 // VALUE SEMANTICS for the sequence class:
 //   Assignments and the copy constructor may be used with sequence
-//   objects.
+//   objects. Sequences may also be moved (move constructor and move
+//   assignment), which takes over the source's storage in O(1).
 
 #ifndef SEQUENCE_H
 #define SEQUENCE_H
+#include <atomic>   // provides atomic
 #include <cstdlib>  // provides size_t
+#include "MemoryResource.h"
 
 namespace CS3358_SP2024
 {
@@ -103,28 +337,114 @@ namespace CS3358_SP2024
       typedef double value_type;
       typedef std::size_t size_type;
       static const size_type DEFAULT_CAPACITY = 30;
+      static const size_type PARALLEL_SORT_THRESHOLD = 1 << 16;
+      typedef const value_type* const_iterator;
+      class const_slice;
       // CONSTRUCTORS and DESTRUCTOR
-      sequence(size_type initial_capacity = DEFAULT_CAPACITY);
+      sequence(size_type initial_capacity = DEFAULT_CAPACITY,
+               memory_resource* resource = 0);
       sequence(const sequence& source);
+      sequence(sequence&& source) noexcept;
       ~sequence();
       // MODIFICATION MEMBER FUNCTIONS
       void resize(size_type new_capacity);
+      void shrink_to_fit();
       void start();
       void advance();
       void insert(const value_type& entry);
       void attach(const value_type& entry);
       void remove_current();
+      void insert_range(const value_type items[], size_type count);
+      void attach_range(const value_type items[], size_type count);
+      void erase_range(size_type count);
+      sequence split_at_cursor();
+      void splice(sequence& other);
+      void seek_lower_bound(const value_type& target);
+      void insert_sorted(const value_type& entry);
+      void sort();
+      void parallel_sort(unsigned threads = 0);
+      template <typename Predicate> size_type remove_if(Predicate pred);
       sequence& operator=(const sequence& source);
+      sequence& operator=(sequence&& source) noexcept;
+      void swap(sequence& other) noexcept;
+      void copy_on_write(bool enable);
       // CONSTANT MEMBER FUNCTIONS
       size_type size() const;
       bool is_item() const;
       value_type current() const;
+      bool is_copy_on_write() const;
+      memory_resource* get_resource() const;
+      const value_type& operator[](size_type index) const;
+      const_iterator begin() const;
+      const_iterator end() const;
+      const_slice slice(size_type begin, size_type end) const;
    private:
       value_type* data;
       size_type used;
       size_type current_index;
       size_type capacity;
+      std::atomic<size_type>* refs;
+      memory_resource* resource;
+      // HELPER MEMBER FUNCTIONS
+      void release();
+      void unshare();
+      void shrink_if_sparse();
+      void make_gap(size_type index, size_type count);
+   };
+
+   // A slice is just a pointer to its first item and a count.
+   class sequence::const_slice
+   {
+   public:
+      size_type size() const { return count; }
+      const value_type& operator[](size_type index) const
+         { return first[index]; }
+      const_iterator begin() const { return first; }
+      const_iterator end() const { return first + count; }
+   private:
+      friend class sequence;
+      const_slice(const value_type* f, size_type c) : first(f), count(c) {}
+      const value_type* first;
+      size_type count;
    };
+
+   // MEMBER TEMPLATES (defined here since they can't be compiled into
+   // Sequence.cpp ahead of time)
+   template <typename Predicate>
+   sequence::size_type sequence::remove_if(Predicate pred)
+   {
+      // Find the first item to remove, so that nothing is unshared
+      // (copy-on-write) unless something is removed.
+      size_type first = 0;
+      while (first < used && !pred(data[first]))
+         ++first;
+      if (first == used)
+         return 0;
+      unshare();
+
+      // Slide each item that is kept down over the gap left by the ones
+      // removed so far (kept is the number kept up to this point).
+      size_type kept = first;
+      size_type new_current = current_index < first ? current_index : first;
+      for (size_type i = first + 1; i < used; ++i)
+      {
+         if (i == current_index)
+            new_current = kept;
+         if (!pred(data[i]))
+            data[kept++] = data[i];
+      }
+      if (current_index >= used)
+         new_current = kept;
+
+      size_type removed = used - kept;
+      used = kept;
+      current_index = new_current;
+      shrink_if_sparse();
+      return removed;
+   }
+
+   // NON-MEMBER FUNCTIONS
+   void swap(sequence& s1, sequence& s2) noexcept;
 }
 
 #endif
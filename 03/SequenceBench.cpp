@@ -0,0 +1,459 @@
+// FILE: SequenceBench.cpp
+//       A non-interactive benchmark program for the sequence engines.
+//
+// DESCRIPTION:
+// insert, attach and remove_current are timed on sequences of n items,
+// for n from 10 up to a maximum (100M by default, growing tenfold), with
+// the cursor placed by each of these edit patterns:
+//   front  - at the first item (start) before each edit
+//   back   - at the last item before each edit
+//   middle - left in the middle of the sequence, wherever each edit
+//            leaves it (edits stay next to each other)
+//   local  - moved forward by 0-15 items from where the last edit left
+//            it (wrapping around to the front at the end)
+//   random - at a random position before each edit
+// Placing the cursor is part of each timed edit: the sequence engines
+// only have start and advance, so reaching an item k places before the
+// cursor (as random and, after a remove, back must) costs k advances,
+// whereas std::vector and std::deque (used for reference, with an index
+// as the cursor) can jump straight there. advance is timed separately,
+// as a full start-to-end scan (pattern "scan").
+//
+// Each round inserts a batch of items and removes it again, then does
+// the same with attach, so the sequence stays at about n items; rounds
+// (with growing batches) are repeated until enough time has been spent.
+// The engines compared are sequence, gap_sequence, rope_sequence,
+// unrolled_sequence and mapped_sequence (on a temporary file, only up to
+// mapped_max_n items, 1M by default), plus compressed_sequence, for the
+// scan only (it is read-only).
+//
+// Each structure is benchmarked at each size in a child process of its
+// own, so that its peak resident set size (RSS) is its own.
+//
+// USAGE:
+//   a3bench [max_n [mapped_max_n]]
+// Results are written to cout as a JSON array, one object per measurement:
+//   {"structure": ..., "op": ..., "pattern": ..., "n": ..., "ops": ...,
+//    "ns_per_op": ..., "allocs": ..., "allocs_per_op": ...,
+//    "peak_rss_kb": ...}
+// allocs counts the calls to malloc, calloc and realloc (which new uses
+// too) made during the timed operations; it is null where they can't be
+// counted (other than with glibc). peak_rss_kb is the peak RSS of the
+// process that benchmarked the structure at that size, in KiB. Progress
+// is written to cerr.
+
+#include "CompressedSequence.h"
+#include "GapSequence.h"
+#include "MappedSequence.h"
+#include "RopeSequence.h"
+#include "Sequence.h"
+#include "UnrolledSequence.h"
+#include <chrono>         // provides steady_clock
+#include <cstdio>         // provides remove
+#include <cstdlib>        // provides atol, getenv, EXIT_SUCCESS
+#include <deque>
+#include <iostream>       // provides cout, cerr
+#include <memory>         // provides unique_ptr
+#include <random>         // provides mt19937
+#include <string>
+#include <sys/resource.h> // provides getrusage
+#include <sys/wait.h>     // provides waitpid
+#include <unistd.h>       // provides fork, getpid, pipe, read, write, _exit
+#include <vector>
+using namespace std;
+using namespace CS3358_SP2024;
+
+typedef chrono::steady_clock Clock;
+
+// Sink for results that must not be optimized away.
+static volatile double sink = 0;
+
+// Minimum wall time spent on one pattern (rounds are added until met).
+const double MIN_TIME_NS = 2e7;
+
+// ALLOCATION COUNTING
+// With glibc, malloc and friends are replaced by versions that count the
+// calls and hand them on to glibc's own (operator new calls malloc too).
+static size_t allocation_count = 0;
+
+#ifdef __GLIBC__
+#define COUNTS_ALLOCATIONS 1
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *p, size_t size);
+
+void *malloc(size_t size) {
+  ++allocation_count;
+  return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+  ++allocation_count;
+  return __libc_calloc(count, size);
+}
+
+void *realloc(void *p, size_t size) {
+  ++allocation_count;
+  return __libc_realloc(p, size);
+}
+}
+#else
+#define COUNTS_ALLOCATIONS 0
+#endif
+
+// PATTERNS
+enum Pattern { FRONT, BACK, MIDDLE, LOCAL, RANDOM };
+const char *PATTERN_NAME[] = {"front", "back", "middle", "local", "random"};
+
+// RESULTS
+struct result {
+  const char *op;
+  const char *pattern;
+  size_t ops;
+  double ns;
+  size_t allocs;
+};
+
+bool first_result = true;
+
+// In a child process (see run_child), the write end of a pipe on which
+// it tells its parent that it has written its first result (so the
+// parent knows to put a comma before the next, even if the child then
+// crashes); -1 otherwise.
+int wrote_fd = -1;
+
+void report(const char *structure, size_t n, const vector<result> &results);
+// Post: The results have been written to cout as JSON objects, each with
+//       the peak RSS of this process (each flushed as it is written).
+
+// ADAPTERS: a uniform cursor interface over each structure being
+// compared. pos is the position of the cursor (size() if there is no
+// current item), which the engines don't expose.
+template <typename Engine> struct engine_maker {
+  static Engine *make() { return new Engine(); }
+};
+
+// A mapped_sequence gets a temporary file of its own, deleted as soon as
+// it is open (it lives on until the mapping is closed).
+template <> struct engine_maker<mapped_sequence> {
+  static mapped_sequence *make() {
+    const char *dir = getenv("TMPDIR");
+    string path = string(dir ? dir : "/tmp") + "/a3bench." +
+                  to_string(long(getpid())) + ".seq";
+    mapped_sequence *s = new mapped_sequence(path.c_str());
+    remove(path.c_str());
+    return s;
+  }
+};
+
+template <typename Engine> class cursor_adapter {
+public:
+  static const bool READ_ONLY = false;
+  cursor_adapter() : s(engine_maker<Engine>::make()), pos(0) {}
+  void fill(size_t n) {
+    for (size_t i = 0; i < n; ++i)
+      s->attach(double(i));
+    s->start();
+    pos = 0;
+  }
+  size_t size() const { return s->size(); }
+  size_t position() const { return pos; }
+  // Pre:  k <= size()
+  // Post: The cursor is at position k (size() meaning no current item),
+  //       reached by advancing, from the front if need be.
+  void seek(size_t k) {
+    if (k < pos) {
+      s->start();
+      pos = 0;
+    }
+    for (; pos < k; ++pos)
+      s->advance();
+  }
+  void insert(double x) {
+    if (pos == s->size())
+      pos = 0;
+    s->insert(x);
+  }
+  void attach(double x) {
+    pos = (pos == s->size()) ? pos : pos + 1;
+    s->attach(x);
+  }
+  void remove_current() { s->remove_current(); }
+  double scan() {
+    double sum = 0;
+    for (s->start(); s->is_item(); s->advance())
+      sum += s->current();
+    pos = s->size();
+    return sum;
+  }
+
+private:
+  unique_ptr<Engine> s;
+  size_t pos;
+};
+
+// std::vector and std::deque, with an index as the cursor.
+template <typename Container> class index_adapter {
+public:
+  static const bool READ_ONLY = false;
+  index_adapter() : pos(0) {}
+  void fill(size_t n) {
+    for (size_t i = 0; i < n; ++i)
+      c.push_back(double(i));
+    pos = 0;
+  }
+  size_t size() const { return c.size(); }
+  size_t position() const { return pos; }
+  void seek(size_t k) { pos = k; }
+  void insert(double x) {
+    if (pos == c.size())
+      pos = 0;
+    c.insert(c.begin() + pos, x);
+  }
+  void attach(double x) {
+    pos = (pos == c.size()) ? pos : pos + 1;
+    c.insert(c.begin() + pos, x);
+  }
+  void remove_current() { c.erase(c.begin() + pos); }
+  double scan() {
+    double sum = 0;
+    for (typename Container::const_iterator it = c.begin(); it != c.end();
+         ++it)
+      sum += *it;
+    pos = c.size();
+    return sum;
+  }
+
+private:
+  Container c;
+  size_t pos;
+};
+
+// compressed_sequence can only be scanned.
+class compressed_adapter {
+public:
+  static const bool READ_ONLY = true;
+  void fill(size_t n) {
+    sequence items(n);
+    for (size_t i = 0; i < n; ++i)
+      items.attach(double(i));
+    c = compressed_sequence(items);
+  }
+  size_t size() const { return c.size(); }
+  size_t position() const { return 0; }
+  void seek(size_t) {}
+  void insert(double) {}
+  void attach(double) {}
+  void remove_current() {}
+  double scan() {
+    double sum = 0;
+    for (c.start(); c.is_item(); c.advance())
+      sum += c.current();
+    return sum;
+  }
+
+private:
+  compressed_sequence c;
+};
+
+// TIMING
+static double elapsed_ns(Clock::time_point since) {
+  return double(chrono::duration_cast<chrono::nanoseconds>(Clock::now() -
+                                                           since)
+                    .count());
+}
+
+template <typename Adapter>
+void place_cursor(Adapter &a, Pattern pattern, mt19937 &gen);
+// Pre:  a holds at least one item.
+// Post: The cursor has been placed for the next edit, as pattern says.
+
+template <typename Adapter>
+void bench_structure(const char *name, size_t n);
+// Post: All operations have been timed on the structure wrapped by
+//       Adapter, holding n items, and reported.
+
+template <typename Adapter>
+void run_child(const char *name, size_t n);
+// Post: bench_structure<Adapter>(name, n) has been run in a child process,
+//       and this process has waited for it.
+
+int main(int argc, char *argv[]) {
+  size_t max_n = 100000000;
+  size_t mapped_max_n = 1000000;
+  if (argc > 1)
+    max_n = size_t(atol(argv[1]));
+  if (argc > 2)
+    mapped_max_n = size_t(atol(argv[2]));
+
+  cout << "[";
+  for (size_t n = 10; n <= max_n; n *= 10) {
+    cerr << "n = " << n << endl;
+    run_child<cursor_adapter<sequence> >("sequence", n);
+    run_child<cursor_adapter<gap_sequence> >("gap_sequence", n);
+    run_child<cursor_adapter<rope_sequence> >("rope_sequence", n);
+    run_child<cursor_adapter<unrolled_sequence> >("unrolled_sequence", n);
+    if (n <= mapped_max_n)
+      run_child<cursor_adapter<mapped_sequence> >("mapped_sequence", n);
+    run_child<compressed_adapter>("compressed_sequence", n);
+    run_child<index_adapter<vector<double> > >("std::vector", n);
+    run_child<index_adapter<deque<double> > >("std::deque", n);
+    if (n > max_n / 10)
+      break;
+  }
+  cout << "\n]" << endl;
+
+  return EXIT_SUCCESS;
+}
+
+void report(const char *structure, size_t n, const vector<result> &results) {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  for (size_t i = 0; i < results.size(); ++i) {
+    const result &r = results[i];
+    cout << (first_result ? "\n" : ",\n") << "  {\"structure\": \""
+         << structure << "\", \"op\": \"" << r.op << "\", \"pattern\": \""
+         << r.pattern << "\", \"n\": " << n << ", \"ops\": " << r.ops
+         << ", \"ns_per_op\": " << r.ns / r.ops;
+    if (COUNTS_ALLOCATIONS)
+      cout << ", \"allocs\": " << r.allocs
+           << ", \"allocs_per_op\": " << double(r.allocs) / r.ops;
+    else
+      cout << ", \"allocs\": null, \"allocs_per_op\": null";
+    cout << ", \"peak_rss_kb\": " << usage.ru_maxrss << "}";
+    cout.flush();
+    if (first_result && wrote_fd >= 0 && write(wrote_fd, "", 1) != 1)
+      cerr << "couldn't tell the parent about the first result" << endl;
+    first_result = false;
+  }
+}
+
+template <typename Adapter>
+void place_cursor(Adapter &a, Pattern pattern, mt19937 &gen) {
+  size_t size = a.size();
+  switch (pattern) {
+  case FRONT:
+    a.seek(0);
+    break;
+  case BACK:
+    a.seek(size - 1);
+    break;
+  case MIDDLE:
+    if (a.position() == size)
+      a.seek(size / 2);
+    break;
+  case LOCAL: {
+    size_t k = a.position() + gen() % 16;
+    a.seek(k < size ? k : 0);
+    break;
+  }
+  case RANDOM:
+    a.seek(gen() % size);
+    break;
+  }
+}
+
+template <typename Adapter>
+void bench_structure(const char *name, size_t n) {
+  Adapter a;
+  a.fill(n);
+  vector<result> results;
+  mt19937 gen(static_cast<unsigned>(n));
+
+  double scan_ns = 0;
+  size_t scan_ops = 0, scan_allocs = 0;
+  while (scan_ns < MIN_TIME_NS) {
+    size_t allocs = allocation_count;
+    Clock::time_point t = Clock::now();
+    sink += a.scan();
+    scan_ns += elapsed_ns(t);
+    scan_allocs += allocation_count - allocs;
+    scan_ops += n;
+  }
+  result scan = {"advance", "scan", scan_ops, scan_ns, scan_allocs};
+  results.push_back(scan);
+
+  for (int p = FRONT; !Adapter::READ_ONLY && p <= RANDOM; ++p) {
+    Pattern pattern = Pattern(p);
+    cerr << "  " << name << " " << PATTERN_NAME[pattern] << endl;
+    // [0] insert, [1] attach, [2] remove_current
+    double ns[3] = {0, 0, 0};
+    size_t ops[3] = {0, 0, 0}, allocs[3] = {0, 0, 0};
+    a.seek(pattern == MIDDLE ? n / 2 : 0);
+    size_t batch = 16;
+    while (ns[0] + ns[1] + ns[2] < MIN_TIME_NS) {
+      Clock::time_point round = Clock::now();
+      for (int op = 0; op < 2; ++op) {
+        size_t before = allocation_count;
+        Clock::time_point t = Clock::now();
+        for (size_t i = 0; i < batch; ++i) {
+          place_cursor(a, pattern, gen);
+          if (op == 0)
+            a.insert(double(i));
+          else
+            a.attach(double(i));
+        }
+        ns[op] += elapsed_ns(t);
+        allocs[op] += allocation_count - before;
+        ops[op] += batch;
+
+        before = allocation_count;
+        t = Clock::now();
+        for (size_t i = 0; i < batch; ++i) {
+          place_cursor(a, pattern, gen);
+          a.remove_current();
+        }
+        ns[2] += elapsed_ns(t);
+        allocs[2] += allocation_count - before;
+        ops[2] += batch;
+      }
+      // Grow the batch while rounds are short, so the clock is read
+      // rarely compared with the operations timed.
+      if (elapsed_ns(round) < MIN_TIME_NS / 8 && batch < (size_t(1) << 16))
+        batch *= 2;
+    }
+    const char *op_name[] = {"insert", "attach", "remove_current"};
+    for (int op = 0; op < 3; ++op) {
+      result r = {op_name[op], PATTERN_NAME[pattern], ops[op], ns[op],
+                  allocs[op]};
+      results.push_back(r);
+    }
+  }
+  report(name, n, results);
+}
+
+template <typename Adapter>
+void run_child(const char *name, size_t n) {
+  cerr << " " << name << endl;
+  cout.flush();
+  int wrote[2] = {-1, -1};
+  pid_t child = pipe(wrote) == 0 ? fork() : -1;
+  if (child < 0) {
+    // No process to spare: benchmark here (peak RSS will include the
+    // structures benchmarked before).
+    if (wrote[0] >= 0) {
+      close(wrote[0]);
+      close(wrote[1]);
+    }
+    bench_structure<Adapter>(name, n);
+    return;
+  }
+  if (child == 0) {
+    close(wrote[0]);
+    wrote_fd = wrote[1];
+    bench_structure<Adapter>(name, n);
+    _exit(0);
+  }
+  close(wrote[1]);
+  int status;
+  waitpid(child, &status, 0);
+  // Whether or not the child got to the end, any result it wrote needs
+  // a comma after it.
+  char byte;
+  if (read(wrote[0], &byte, 1) == 1)
+    first_result = false;
+  close(wrote[0]);
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    cerr << name << " failed at n = " << n << endl;
+}
@@ -0,0 +1,549 @@
+// FILE: SequenceFuzz.cpp
+//       A non-interactive differential test program for sequence.
+//
+// DESCRIPTION:
+// A few sequences are put through a long series of random operations,
+// and after each one they are checked against a model (a vector of the
+// items and the position of the current item) that does the same thing
+// the simple way. The operations cover the cursor functions, the range
+// functions, split_at_cursor and splice, seek_lower_bound and
+// insert_sorted, sort and parallel_sort, remove_if, copy-on-write,
+// resize and shrink_to_fit, and copying, moving and swapping sequences
+// (so items also move between sequences). Items are compared bit for
+// bit, so -0.0 can't pass for 0.0.
+//
+// Each sequence is allocated from one of several resources: the heap,
+// two tracking resources that are equal to each other (they share one
+// record of blocks), a third tracking resource, and a monotonic_arena
+// over that one. A tracking resource records every block it hands out,
+// so a block given back to the wrong resource, with the wrong size or
+// twice, is caught, as is a block still live at the end. Copies, moves,
+// swaps and splices are checked to carry the resource and copy-on-write
+// mode as Sequence.h says.
+//
+// Every so often a large sequence (past PARALLEL_SORT_THRESHOLD) of
+// random bit patterns, NaNs and zeros of both signs included, is sorted
+// with sort and with parallel_sort, and both are compared with a stable
+// sort by the key Sequence.h describes.
+//
+// USAGE:
+//   a3fuzz [operations [seed]]
+// Prints the number of operations checked and "passed", or the first
+// operation that went wrong and "FAILED"; the exit status is
+// EXIT_SUCCESS only if it passed. Building it with
+// -fsanitize=address,undefined also catches what the checks can't see.
+
+#include "MemoryResource.h"
+#include "Sequence.h"
+#include "SequenceStats.h"
+#include <algorithm> // provides lower_bound, max, min, stable_sort,
+                     // upper_bound
+#include <cstdint>   // provides uint64_t
+#include <cstdlib>   // provides atol, exit, EXIT_SUCCESS, EXIT_FAILURE
+#include <cstring>   // provides memcmp, memcpy
+#include <iostream>  // provides cout
+#include <map>
+#include <random>  // provides mt19937_64
+#include <utility> // provides make_pair, move, pair, swap
+#include <vector>
+using namespace std;
+using namespace CS3358_SP2024;
+
+// The number of sequences operated on.
+const size_t SLOTS = 5;
+// The most items added or removed by one range operation.
+const size_t MAX_RANGE = 40;
+// A sequence with more items than this is cut in half.
+const size_t MAX_SIZE = 1000;
+// How many operations come between two large sorts.
+const size_t BIG_SORT_EVERY = 5000;
+
+// The blocks handed out by a group of equal tracking resources, and the
+// number of bad deallocations seen.
+struct block_record {
+  map<void *, pair<size_t, size_t>> live;
+  size_t errors;
+  block_record() : errors(0) {}
+};
+
+// A resource that checks every deallocation against what it allocated.
+// Resources sharing a record are equal, as each may free the others'
+// blocks.
+class tracking_resource : public memory_resource {
+public:
+  explicit tracking_resource(block_record *record) : record(record) {}
+
+private:
+  block_record *record;
+  void *do_allocate(size_t bytes, size_t alignment) {
+    void *p = ::operator new(bytes);
+    record->live[p] = make_pair(bytes, alignment);
+    return p;
+  }
+  void do_deallocate(void *p, size_t bytes, size_t alignment) {
+    map<void *, pair<size_t, size_t>>::iterator it = record->live.find(p);
+    if (it == record->live.end() || it->second.first != bytes ||
+        it->second.second != alignment) {
+      ++record->errors;
+      return;
+    }
+    record->live.erase(it);
+    ::operator delete(p);
+  }
+  bool do_is_equal(const memory_resource &other) const {
+    const tracking_resource *t =
+        dynamic_cast<const tracking_resource *>(&other);
+    return t != 0 && t->record == record;
+  }
+};
+
+// What a sequence should hold: its items, the position of its current
+// item (items.size() if there is none), its copy-on-write mode and its
+// resource.
+struct model {
+  vector<double> items;
+  size_t current;
+  bool cow;
+  memory_resource *resource;
+  model() : current(0), cow(false), resource(0) {}
+};
+
+enum operation {
+  INSERT,
+  ATTACH,
+  REMOVE_CURRENT,
+  START,
+  ADVANCE,
+  INSERT_RANGE,
+  ATTACH_RANGE,
+  ERASE_RANGE,
+  SPLIT_AT_CURSOR,
+  SPLICE,
+  SEEK_LOWER_BOUND,
+  INSERT_SORTED,
+  SORT,
+  PARALLEL_SORT,
+  REMOVE_IF,
+  COPY_CONSTRUCT,
+  COPY_ASSIGN,
+  MOVE_CONSTRUCT,
+  MOVE_ASSIGN,
+  SWAP,
+  COPY_ON_WRITE,
+  RESIZE,
+  SHRINK_TO_FIT,
+  NEW_SEQUENCE,
+  OPERATIONS
+};
+
+const char *const OPERATION_NAMES[OPERATIONS] = {
+    "insert",           "attach",           "remove_current",
+    "start",            "advance",          "insert_range",
+    "attach_range",     "erase_range",      "split_at_cursor",
+    "splice",           "seek_lower_bound", "insert_sorted",
+    "sort",             "parallel_sort",    "remove_if",
+    "copy constructor", "copy assignment",  "move constructor",
+    "move assignment",  "swap",             "copy_on_write",
+    "resize",           "shrink_to_fit",    "new sequence"};
+
+static mt19937_64 rng;
+static size_t op_number = 0;
+static const char *op_name = "";
+
+size_t pick(size_t n) { return n == 0 ? 0 : size_t(rng() % n); }
+
+// A small half-integer (so that there are many equal items, and sums
+// are exact), or now and then a zero of either sign.
+double pick_item() {
+  if (pick(16) == 0)
+    return pick(2) ? -0.0 : 0.0;
+  return double(int(pick(41)) - 20) / 2;
+}
+
+vector<double> pick_items(size_t count) {
+  vector<double> items(count);
+  for (size_t i = 0; i < count; ++i)
+    items[i] = pick_item();
+  return items;
+}
+
+// Any bit pattern at all, NaNs included, and zeros of both signs.
+double pick_bits() {
+  uint64_t bits = rng();
+  if (pick(8) == 0)
+    bits &= uint64_t(1) << 63;
+  double x;
+  memcpy(&x, &bits, sizeof(x));
+  return x;
+}
+
+bool same_bits(double a, double b) { return memcmp(&a, &b, sizeof(a)) == 0; }
+
+// The order sort puts doubles in (see sort in Sequence.h): as by <,
+// but with -0.0 before 0.0, and NaNs at the ends by their sign.
+uint64_t sort_key(double x) {
+  const uint64_t sign = uint64_t(1) << 63;
+  uint64_t bits;
+  memcpy(&bits, &x, sizeof(bits));
+  return (bits & sign) ? ~bits : (bits | sign);
+}
+
+bool key_less(double a, double b) { return sort_key(a) < sort_key(b); }
+
+bool same_resource(memory_resource *a, memory_resource *b) {
+  return a == b || (a != 0 && b != 0 && a->is_equal(*b));
+}
+
+void fail(size_t slot, const char *what) {
+  cout << "operation " << op_number << " (" << op_name << "), sequence "
+       << slot << ": " << what << endl
+       << "FAILED" << endl;
+  exit(EXIT_FAILURE);
+}
+
+// Pre:  none
+// Post: s has been checked against m, and the program has stopped if
+//       they differ.
+void check(const sequence &s, const model &m, size_t slot) {
+  size_t n = m.items.size();
+  if (s.size() != n)
+    fail(slot, "wrong size");
+  if (s.is_item() != (m.current < n))
+    fail(slot, "wrong is_item");
+  if (m.current < n && !same_bits(s.current(), m.items[m.current]))
+    fail(slot, "wrong current item");
+  if (s.is_copy_on_write() != m.cow)
+    fail(slot, "wrong copy-on-write mode");
+  if (s.get_resource() != m.resource)
+    fail(slot, "wrong resource");
+  if (s.end() - s.begin() != ptrdiff_t(n))
+    fail(slot, "begin to end is not size() items");
+  for (size_t i = 0; i < n; ++i)
+    if (!same_bits(s[i], m.items[i]) || !same_bits(s.begin()[i], s[i]))
+      fail(slot, "wrong item");
+
+  size_t first = pick(n + 1);
+  size_t last = first + pick(n - first + 1);
+  sequence::const_slice view = s.slice(first, last);
+  if (view.size() != last - first ||
+      view.end() - view.begin() != ptrdiff_t(last - first))
+    fail(slot, "wrong slice size");
+  for (size_t i = 0; i < view.size(); ++i)
+    if (!same_bits(view[i], m.items[first + i]))
+      fail(slot, "wrong slice item");
+
+  if (n > 0) {
+    double total = 0, low = m.items[0], high = m.items[0];
+    for (size_t i = 0; i < n; ++i) {
+      total += m.items[i];
+      low = min(low, m.items[i]);
+      high = max(high, m.items[i]);
+    }
+    if (sum(s) != total || minimum(s) != low || maximum(s) != high)
+      fail(slot, "wrong sum, minimum or maximum");
+  }
+}
+
+// Pre:  none
+// Post: s and m have been sorted (unless m already was, with <, since
+//       seek_lower_bound and insert_sorted need only that).
+void sort_if_needed(sequence &s, model &m) {
+  for (size_t i = 1; i < m.items.size(); ++i)
+    if (m.items[i] < m.items[i - 1]) {
+      s.sort();
+      stable_sort(m.items.begin(), m.items.end(), key_less);
+      m.current = 0;
+      return;
+    }
+}
+
+// Pre:  none
+// Post: A large sequence of random bit patterns has been sorted with
+//       sort and with parallel_sort, and the program has stopped if
+//       either differs from a stable sort by sort_key.
+void check_big_sort(memory_resource *resource) {
+  op_name = "large sort";
+  size_t n = sequence::PARALLEL_SORT_THRESHOLD + pick(100000);
+  vector<double> items(n);
+  for (size_t i = 0; i < n; ++i)
+    items[i] = pick_bits();
+  sequence a(1, resource);
+  a.attach_range(&items[0], n);
+  sequence b(a);
+  a.sort();
+  b.parallel_sort(unsigned(1 + pick(8)));
+  stable_sort(items.begin(), items.end(), key_less);
+  for (size_t i = 0; i < n; ++i) {
+    if (!same_bits(a[i], items[i]))
+      fail(0, "sort gave the wrong order");
+    if (!same_bits(b[i], items[i]))
+      fail(0, "parallel_sort gave the wrong order");
+  }
+  if (!a.is_item() || !same_bits(a.current(), items[0]) || !b.is_item() ||
+      !same_bits(b.current(), items[0]))
+    fail(0, "the first item is not the current item after sorting");
+}
+
+int main(int argc, char *argv[]) {
+  size_t operations = 100000;
+  size_t seed = 1;
+  if (argc > 1)
+    operations = size_t(atol(argv[1]));
+  if (argc > 2)
+    seed = size_t(atol(argv[2]));
+  rng.seed(seed);
+
+  block_record shared_record, other_record;
+  {
+    tracking_resource shared1(&shared_record), shared2(&shared_record);
+    tracking_resource other(&other_record);
+    monotonic_arena arena(256, &other);
+    memory_resource *const resources[] = {0, &shared1, &shared2, &other,
+                                          &arena};
+    const size_t RESOURCES = sizeof(resources) / sizeof(resources[0]);
+
+    sequence *slots[SLOTS];
+    model models[SLOTS];
+    for (size_t i = 0; i < SLOTS; ++i) {
+      models[i].resource = resources[i % RESOURCES];
+      slots[i] = new sequence(1 + pick(50), models[i].resource);
+    }
+
+    for (op_number = 1; op_number <= operations; ++op_number) {
+      size_t i = pick(SLOTS), j = pick(SLOTS);
+      sequence &s = *slots[i];
+      model &m = models[i];
+      size_t n = m.items.size();
+      operation op = operation(pick(OPERATIONS));
+      op_name = OPERATION_NAMES[op];
+
+      if (n > MAX_SIZE) {
+        op_name = "cut in half";
+        s.start();
+        s.erase_range(n / 2);
+        m.items.erase(m.items.begin(), m.items.begin() + n / 2);
+        m.current = 0;
+        op = OPERATIONS;
+      }
+
+      switch (op) {
+      case INSERT: {
+        double x = pick_item();
+        s.insert(x);
+        if (m.current == n)
+          m.current = 0;
+        m.items.insert(m.items.begin() + m.current, x);
+        break;
+      }
+      case ATTACH: {
+        double x = pick_item();
+        s.attach(x);
+        m.current = m.current < n ? m.current + 1 : n;
+        m.items.insert(m.items.begin() + m.current, x);
+        break;
+      }
+      case REMOVE_CURRENT:
+        if (m.current < n) {
+          s.remove_current();
+          m.items.erase(m.items.begin() + m.current);
+        }
+        break;
+      case START:
+        s.start();
+        m.current = 0;
+        break;
+      case ADVANCE:
+        if (m.current < n) {
+          s.advance();
+          ++m.current;
+        }
+        break;
+      case INSERT_RANGE: {
+        vector<double> items = pick_items(pick(MAX_RANGE + 1));
+        s.insert_range(items.empty() ? 0 : &items[0], items.size());
+        if (!items.empty()) {
+          if (m.current == n)
+            m.current = 0;
+          m.items.insert(m.items.begin() + m.current, items.begin(),
+                         items.end());
+        }
+        break;
+      }
+      case ATTACH_RANGE: {
+        vector<double> items = pick_items(pick(MAX_RANGE + 1));
+        s.attach_range(items.empty() ? 0 : &items[0], items.size());
+        if (!items.empty()) {
+          size_t at = m.current < n ? m.current + 1 : n;
+          m.items.insert(m.items.begin() + at, items.begin(), items.end());
+          m.current = at + items.size() - 1;
+        }
+        break;
+      }
+      case ERASE_RANGE:
+        if (m.current < n) {
+          size_t count = 1 + pick(MAX_RANGE);
+          s.erase_range(count);
+          m.items.erase(m.items.begin() + m.current,
+                        m.items.begin() + min(n, m.current + count));
+        }
+        break;
+      case SPLIT_AT_CURSOR:
+        if (j != i) {
+          sequence tail = s.split_at_cursor();
+          model t;
+          t.cow = m.cow;
+          t.resource = m.resource;
+          if (m.current < n) {
+            t.items.assign(m.items.begin() + m.current, m.items.end());
+            m.items.resize(m.current);
+          }
+          check(tail, t, j);
+          *slots[j] = move(tail);
+          models[j] = t;
+        }
+        break;
+      case SPLICE:
+        if (j != i) {
+          model &o = models[j];
+          bool adopt = n == 0 && !o.items.empty() &&
+                       same_resource(m.resource, o.resource) &&
+                       m.cow == o.cow;
+          s.splice(*slots[j]);
+          if (adopt) {
+            // The arrays are swapped, resources and all.
+            m.items.swap(o.items);
+            m.current = m.items.size();
+            swap(m.resource, o.resource);
+          } else if (!o.items.empty()) {
+            m.items.insert(m.items.begin() + m.current, o.items.begin(),
+                           o.items.end());
+            m.current += o.items.size();
+            o.items.clear();
+          }
+          o.current = 0;
+        }
+        break;
+      case SEEK_LOWER_BOUND: {
+        sort_if_needed(s, m);
+        double target = pick_item();
+        s.seek_lower_bound(target);
+        m.current = lower_bound(m.items.begin(), m.items.end(), target) -
+                    m.items.begin();
+        break;
+      }
+      case INSERT_SORTED: {
+        sort_if_needed(s, m);
+        double x = pick_item();
+        s.insert_sorted(x);
+        m.current =
+            upper_bound(m.items.begin(), m.items.end(), x) - m.items.begin();
+        m.items.insert(m.items.begin() + m.current, x);
+        break;
+      }
+      case SORT:
+      case PARALLEL_SORT:
+        if (op == SORT)
+          s.sort();
+        else
+          s.parallel_sort(unsigned(1 + pick(4)));
+        stable_sort(m.items.begin(), m.items.end(), key_less);
+        m.current = 0;
+        break;
+      case REMOVE_IF: {
+        double target = pick_item();
+        bool below = pick(2) == 0;
+        size_t removed = s.remove_if([=](double x) {
+          return below ? x < target : x == target;
+        });
+        vector<double> kept;
+        size_t current = m.items.size();
+        for (size_t k = 0; k < n; ++k) {
+          if (k == m.current)
+            current = kept.size();
+          double x = m.items[k];
+          if (!(below ? x < target : x == target))
+            kept.push_back(x);
+        }
+        if (removed != n - kept.size())
+          fail(i, "remove_if returned the wrong count");
+        m.items.swap(kept);
+        m.current = m.current < n ? current : m.items.size();
+        break;
+      }
+      case COPY_CONSTRUCT:
+        if (j != i) {
+          delete slots[j];
+          slots[j] = new sequence(s);
+          models[j] = m;
+        }
+        break;
+      case COPY_ASSIGN:
+        *slots[j] = s;
+        if (j != i) {
+          memory_resource *kept = models[j].resource;
+          models[j] = m;
+          models[j].resource = kept;
+        }
+        break;
+      case MOVE_CONSTRUCT:
+      case MOVE_ASSIGN:
+        if (j != i) {
+          if (op == MOVE_CONSTRUCT) {
+            delete slots[j];
+            slots[j] = new sequence(move(s));
+          } else {
+            *slots[j] = move(s);
+          }
+          models[j] = m;
+          // The moved-from sequence is empty, but keeps its resource.
+          m.items.clear();
+          m.current = 0;
+          m.cow = false;
+        }
+        break;
+      case SWAP:
+        if (pick(2) == 0)
+          s.swap(*slots[j]);
+        else
+          swap(s, *slots[j]);
+        swap(models[i], models[j]);
+        break;
+      case COPY_ON_WRITE:
+        m.cow = pick(2) == 0;
+        s.copy_on_write(m.cow);
+        break;
+      case RESIZE:
+        s.resize(pick(2 * n + 40));
+        break;
+      case SHRINK_TO_FIT:
+        s.shrink_to_fit();
+        break;
+      case NEW_SEQUENCE:
+        delete slots[i];
+        m = model();
+        m.resource = resources[pick(RESOURCES)];
+        slots[i] = new sequence(1 + pick(50), m.resource);
+        break;
+      case OPERATIONS:
+        break;
+      }
+
+      check(*slots[i], models[i], i);
+      check(*slots[j], models[j], j);
+      if (shared_record.errors != 0 || other_record.errors != 0)
+        fail(i, "storage was given back to the wrong resource or twice");
+      if (op_number % BIG_SORT_EVERY == 0)
+        check_big_sort(resources[pick(RESOURCES)]);
+    }
+
+    for (size_t i = 0; i < SLOTS; ++i)
+      delete slots[i];
+  }
+  op_name = "end";
+  if (!shared_record.live.empty() || !other_record.live.empty() ||
+      shared_record.errors != 0 || other_record.errors != 0)
+    fail(0, "storage was not given back, or not properly");
+
+  cout << operations << " operations checked: passed" << endl;
+  return EXIT_SUCCESS;
+}
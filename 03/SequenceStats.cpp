@@ -0,0 +1,469 @@
+// FILE: SequenceStats.cpp
+// FUNCTIONS IMPLEMENTED: numeric reductions over a sequence (see
+// SequenceStats.h for documentation)
+//
+// Each reduction is a kernel over a plain array of doubles, written once
+// as a scalar loop and again with AVX2 and AVX-512 intrinsics. The
+// intrinsic versions are compiled with GCC/Clang target attributes, so
+// no special compiler flags are needed, and best_kernels() picks the
+// widest set the CPU supports the first time it is called. The vector
+// kernels keep several independent accumulators per loop (so one add
+// doesn't have to wait for the previous one), fold them together at the
+// end, and finish the last few items (fewer than a vector's worth) with
+// scalar code.
+
+#include "SequenceStats.h"
+#include <cassert>
+#include <cstddef>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SEQUENCE_STATS_X86
+#include <immintrin.h>
+#endif
+using namespace std;
+
+namespace {
+// Kahan summation: c holds the (negated) low-order bits lost by the
+// last addition to s, and is subtracted back out of the next item.
+struct kahan_sum {
+  double s;
+  double c;
+  kahan_sum() : s(0), c(0) {}
+  void add(double x) {
+    double y = x - c;
+    double t = s + y;
+    c = (t - s) - y;
+    s = t;
+  }
+};
+
+// Pre:  s and c each hold lanes values, the sums and compensations of
+//       lanes independent Kahan sums.
+// Post: The lanes sums have been combined (still compensated) into the
+//       Kahan sum returned.
+kahan_sum merge_lanes(const double s[], const double c[], size_t lanes) {
+  kahan_sum k;
+  for (size_t i = 0; i < lanes; ++i) {
+    k.add(s[i]);
+    k.add(-c[i]);
+  }
+  return k;
+}
+
+struct kernels {
+  double (*sum)(const double *p, size_t n, bool compensated);
+  void (*min_max)(const double *p, size_t n, double &lo, double &hi);
+  double (*dot)(const double *p, const double *q, size_t n,
+                bool compensated);
+  double (*sq_dev)(const double *p, size_t n, double m, bool compensated);
+};
+
+// SCALAR KERNELS
+double scalar_sum(const double *p, size_t n, bool compensated) {
+  if (compensated) {
+    kahan_sum k;
+    for (size_t i = 0; i < n; ++i)
+      k.add(p[i]);
+    return k.s;
+  }
+  double s = 0;
+  for (size_t i = 0; i < n; ++i)
+    s += p[i];
+  return s;
+}
+
+// Pre:  n > 0
+void scalar_min_max(const double *p, size_t n, double &lo, double &hi) {
+  lo = hi = p[0];
+  for (size_t i = 1; i < n; ++i) {
+    if (p[i] < lo)
+      lo = p[i];
+    if (p[i] > hi)
+      hi = p[i];
+  }
+}
+
+double scalar_dot(const double *p, const double *q, size_t n,
+                  bool compensated) {
+  if (compensated) {
+    kahan_sum k;
+    for (size_t i = 0; i < n; ++i)
+      k.add(p[i] * q[i]);
+    return k.s;
+  }
+  double s = 0;
+  for (size_t i = 0; i < n; ++i)
+    s += p[i] * q[i];
+  return s;
+}
+
+// Returns the sum of (p[i] - m)^2.
+double scalar_sq_dev(const double *p, size_t n, double m, bool compensated) {
+  if (compensated) {
+    kahan_sum k;
+    for (size_t i = 0; i < n; ++i)
+      k.add((p[i] - m) * (p[i] - m));
+    return k.s;
+  }
+  double s = 0;
+  for (size_t i = 0; i < n; ++i)
+    s += (p[i] - m) * (p[i] - m);
+  return s;
+}
+
+#ifdef SEQUENCE_STATS_X86
+// AVX2 KERNELS (4 doubles per vector)
+__attribute__((target("avx2"))) double avx2_hsum(__m256d v) {
+  double lanes[4];
+  _mm256_storeu_pd(lanes, v);
+  return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+__attribute__((target("avx2"))) kahan_sum avx2_merge(__m256d s, __m256d c) {
+  double ls[4], lc[4];
+  _mm256_storeu_pd(ls, s);
+  _mm256_storeu_pd(lc, c);
+  return merge_lanes(ls, lc, 4);
+}
+
+__attribute__((target("avx2"))) double avx2_sum(const double *p, size_t n,
+                                                bool compensated) {
+  size_t i = 0;
+  if (compensated) {
+    __m256d s = _mm256_setzero_pd();
+    __m256d c = _mm256_setzero_pd();
+    for (; i + 4 <= n; i += 4) {
+      __m256d y = _mm256_sub_pd(_mm256_loadu_pd(p + i), c);
+      __m256d t = _mm256_add_pd(s, y);
+      c = _mm256_sub_pd(_mm256_sub_pd(t, s), y);
+      s = t;
+    }
+    kahan_sum k = avx2_merge(s, c);
+    for (; i < n; ++i)
+      k.add(p[i]);
+    return k.s;
+  }
+  __m256d a0 = _mm256_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+  for (; i + 16 <= n; i += 16) {
+    a0 = _mm256_add_pd(a0, _mm256_loadu_pd(p + i));
+    a1 = _mm256_add_pd(a1, _mm256_loadu_pd(p + i + 4));
+    a2 = _mm256_add_pd(a2, _mm256_loadu_pd(p + i + 8));
+    a3 = _mm256_add_pd(a3, _mm256_loadu_pd(p + i + 12));
+  }
+  for (; i + 4 <= n; i += 4)
+    a0 = _mm256_add_pd(a0, _mm256_loadu_pd(p + i));
+  double s = avx2_hsum(_mm256_add_pd(_mm256_add_pd(a0, a1),
+                                     _mm256_add_pd(a2, a3)));
+  for (; i < n; ++i)
+    s += p[i];
+  return s;
+}
+
+__attribute__((target("avx2"))) void avx2_min_max(const double *p, size_t n,
+                                                  double &lo, double &hi) {
+  size_t i = 0;
+  lo = hi = p[0];
+  if (n >= 4) {
+    __m256d vlo = _mm256_loadu_pd(p), vhi = vlo;
+    for (i = 4; i + 4 <= n; i += 4) {
+      __m256d x = _mm256_loadu_pd(p + i);
+      vlo = _mm256_min_pd(vlo, x);
+      vhi = _mm256_max_pd(vhi, x);
+    }
+    double llo[4], lhi[4];
+    _mm256_storeu_pd(llo, vlo);
+    _mm256_storeu_pd(lhi, vhi);
+    for (size_t j = 0; j < 4; ++j) {
+      if (llo[j] < lo)
+        lo = llo[j];
+      if (lhi[j] > hi)
+        hi = lhi[j];
+    }
+  }
+  for (; i < n; ++i) {
+    if (p[i] < lo)
+      lo = p[i];
+    if (p[i] > hi)
+      hi = p[i];
+  }
+}
+
+__attribute__((target("avx2"))) double
+avx2_dot(const double *p, const double *q, size_t n, bool compensated) {
+  size_t i = 0;
+  if (compensated) {
+    __m256d s = _mm256_setzero_pd();
+    __m256d c = _mm256_setzero_pd();
+    for (; i + 4 <= n; i += 4) {
+      __m256d x = _mm256_mul_pd(_mm256_loadu_pd(p + i),
+                                _mm256_loadu_pd(q + i));
+      __m256d y = _mm256_sub_pd(x, c);
+      __m256d t = _mm256_add_pd(s, y);
+      c = _mm256_sub_pd(_mm256_sub_pd(t, s), y);
+      s = t;
+    }
+    kahan_sum k = avx2_merge(s, c);
+    for (; i < n; ++i)
+      k.add(p[i] * q[i]);
+    return k.s;
+  }
+  __m256d a0 = _mm256_setzero_pd(), a1 = a0;
+  for (; i + 8 <= n; i += 8) {
+    a0 = _mm256_add_pd(a0, _mm256_mul_pd(_mm256_loadu_pd(p + i),
+                                         _mm256_loadu_pd(q + i)));
+    a1 = _mm256_add_pd(a1, _mm256_mul_pd(_mm256_loadu_pd(p + i + 4),
+                                         _mm256_loadu_pd(q + i + 4)));
+  }
+  for (; i + 4 <= n; i += 4)
+    a0 = _mm256_add_pd(a0, _mm256_mul_pd(_mm256_loadu_pd(p + i),
+                                         _mm256_loadu_pd(q + i)));
+  double s = avx2_hsum(_mm256_add_pd(a0, a1));
+  for (; i < n; ++i)
+    s += p[i] * q[i];
+  return s;
+}
+
+__attribute__((target("avx2"))) double
+avx2_sq_dev(const double *p, size_t n, double m, bool compensated) {
+  size_t i = 0;
+  __m256d vm = _mm256_set1_pd(m);
+  if (compensated) {
+    __m256d s = _mm256_setzero_pd();
+    __m256d c = _mm256_setzero_pd();
+    for (; i + 4 <= n; i += 4) {
+      __m256d d = _mm256_sub_pd(_mm256_loadu_pd(p + i), vm);
+      __m256d y = _mm256_sub_pd(_mm256_mul_pd(d, d), c);
+      __m256d t = _mm256_add_pd(s, y);
+      c = _mm256_sub_pd(_mm256_sub_pd(t, s), y);
+      s = t;
+    }
+    kahan_sum k = avx2_merge(s, c);
+    for (; i < n; ++i)
+      k.add((p[i] - m) * (p[i] - m));
+    return k.s;
+  }
+  __m256d a0 = _mm256_setzero_pd(), a1 = a0;
+  for (; i + 8 <= n; i += 8) {
+    __m256d d0 = _mm256_sub_pd(_mm256_loadu_pd(p + i), vm);
+    __m256d d1 = _mm256_sub_pd(_mm256_loadu_pd(p + i + 4), vm);
+    a0 = _mm256_add_pd(a0, _mm256_mul_pd(d0, d0));
+    a1 = _mm256_add_pd(a1, _mm256_mul_pd(d1, d1));
+  }
+  for (; i + 4 <= n; i += 4) {
+    __m256d d = _mm256_sub_pd(_mm256_loadu_pd(p + i), vm);
+    a0 = _mm256_add_pd(a0, _mm256_mul_pd(d, d));
+  }
+  double s = avx2_hsum(_mm256_add_pd(a0, a1));
+  for (; i < n; ++i)
+    s += (p[i] - m) * (p[i] - m);
+  return s;
+}
+
+// AVX-512 KERNELS (8 doubles per vector)
+__attribute__((target("avx512f"))) double avx512_hsum(__m512d v) {
+  double lanes[8];
+  _mm512_storeu_pd(lanes, v);
+  return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) +
+         ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+}
+
+__attribute__((target("avx512f"))) kahan_sum avx512_merge(__m512d s,
+                                                          __m512d c) {
+  double ls[8], lc[8];
+  _mm512_storeu_pd(ls, s);
+  _mm512_storeu_pd(lc, c);
+  return merge_lanes(ls, lc, 8);
+}
+
+__attribute__((target("avx512f"))) double
+avx512_sum(const double *p, size_t n, bool compensated) {
+  size_t i = 0;
+  if (compensated) {
+    __m512d s = _mm512_setzero_pd();
+    __m512d c = _mm512_setzero_pd();
+    for (; i + 8 <= n; i += 8) {
+      __m512d y = _mm512_sub_pd(_mm512_loadu_pd(p + i), c);
+      __m512d t = _mm512_add_pd(s, y);
+      c = _mm512_sub_pd(_mm512_sub_pd(t, s), y);
+      s = t;
+    }
+    kahan_sum k = avx512_merge(s, c);
+    for (; i < n; ++i)
+      k.add(p[i]);
+    return k.s;
+  }
+  __m512d a0 = _mm512_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+  for (; i + 32 <= n; i += 32) {
+    a0 = _mm512_add_pd(a0, _mm512_loadu_pd(p + i));
+    a1 = _mm512_add_pd(a1, _mm512_loadu_pd(p + i + 8));
+    a2 = _mm512_add_pd(a2, _mm512_loadu_pd(p + i + 16));
+    a3 = _mm512_add_pd(a3, _mm512_loadu_pd(p + i + 24));
+  }
+  for (; i + 8 <= n; i += 8)
+    a0 = _mm512_add_pd(a0, _mm512_loadu_pd(p + i));
+  double s = avx512_hsum(_mm512_add_pd(_mm512_add_pd(a0, a1),
+                                       _mm512_add_pd(a2, a3)));
+  for (; i < n; ++i)
+    s += p[i];
+  return s;
+}
+
+__attribute__((target("avx512f"))) void
+avx512_min_max(const double *p, size_t n, double &lo, double &hi) {
+  size_t i = 0;
+  lo = hi = p[0];
+  if (n >= 8) {
+    __m512d vlo = _mm512_loadu_pd(p), vhi = vlo;
+    for (i = 8; i + 8 <= n; i += 8) {
+      __m512d x = _mm512_loadu_pd(p + i);
+      vlo = _mm512_min_pd(vlo, x);
+      vhi = _mm512_max_pd(vhi, x);
+    }
+    double llo[8], lhi[8];
+    _mm512_storeu_pd(llo, vlo);
+    _mm512_storeu_pd(lhi, vhi);
+    for (size_t j = 0; j < 8; ++j) {
+      if (llo[j] < lo)
+        lo = llo[j];
+      if (lhi[j] > hi)
+        hi = lhi[j];
+    }
+  }
+  for (; i < n; ++i) {
+    if (p[i] < lo)
+      lo = p[i];
+    if (p[i] > hi)
+      hi = p[i];
+  }
+}
+
+__attribute__((target("avx512f"))) double
+avx512_dot(const double *p, const double *q, size_t n, bool compensated) {
+  size_t i = 0;
+  if (compensated) {
+    __m512d s = _mm512_setzero_pd();
+    __m512d c = _mm512_setzero_pd();
+    for (; i + 8 <= n; i += 8) {
+      __m512d x = _mm512_mul_pd(_mm512_loadu_pd(p + i),
+                                _mm512_loadu_pd(q + i));
+      __m512d y = _mm512_sub_pd(x, c);
+      __m512d t = _mm512_add_pd(s, y);
+      c = _mm512_sub_pd(_mm512_sub_pd(t, s), y);
+      s = t;
+    }
+    kahan_sum k = avx512_merge(s, c);
+    for (; i < n; ++i)
+      k.add(p[i] * q[i]);
+    return k.s;
+  }
+  __m512d a0 = _mm512_setzero_pd(), a1 = a0;
+  for (; i + 16 <= n; i += 16) {
+    a0 = _mm512_add_pd(a0, _mm512_mul_pd(_mm512_loadu_pd(p + i),
+                                         _mm512_loadu_pd(q + i)));
+    a1 = _mm512_add_pd(a1, _mm512_mul_pd(_mm512_loadu_pd(p + i + 8),
+                                         _mm512_loadu_pd(q + i + 8)));
+  }
+  for (; i + 8 <= n; i += 8)
+    a0 = _mm512_add_pd(a0, _mm512_mul_pd(_mm512_loadu_pd(p + i),
+                                         _mm512_loadu_pd(q + i)));
+  double s = avx512_hsum(_mm512_add_pd(a0, a1));
+  for (; i < n; ++i)
+    s += p[i] * q[i];
+  return s;
+}
+
+__attribute__((target("avx512f"))) double
+avx512_sq_dev(const double *p, size_t n, double m, bool compensated) {
+  size_t i = 0;
+  __m512d vm = _mm512_set1_pd(m);
+  if (compensated) {
+    __m512d s = _mm512_setzero_pd();
+    __m512d c = _mm512_setzero_pd();
+    for (; i + 8 <= n; i += 8) {
+      __m512d d = _mm512_sub_pd(_mm512_loadu_pd(p + i), vm);
+      __m512d y = _mm512_sub_pd(_mm512_mul_pd(d, d), c);
+      __m512d t = _mm512_add_pd(s, y);
+      c = _mm512_sub_pd(_mm512_sub_pd(t, s), y);
+      s = t;
+    }
+    kahan_sum k = avx512_merge(s, c);
+    for (; i < n; ++i)
+      k.add((p[i] - m) * (p[i] - m));
+    return k.s;
+  }
+  __m512d a0 = _mm512_setzero_pd(), a1 = a0;
+  for (; i + 16 <= n; i += 16) {
+    __m512d d0 = _mm512_sub_pd(_mm512_loadu_pd(p + i), vm);
+    __m512d d1 = _mm512_sub_pd(_mm512_loadu_pd(p + i + 8), vm);
+    a0 = _mm512_add_pd(a0, _mm512_mul_pd(d0, d0));
+    a1 = _mm512_add_pd(a1, _mm512_mul_pd(d1, d1));
+  }
+  for (; i + 8 <= n; i += 8) {
+    __m512d d = _mm512_sub_pd(_mm512_loadu_pd(p + i), vm);
+    a0 = _mm512_add_pd(a0, _mm512_mul_pd(d, d));
+  }
+  double s = avx512_hsum(_mm512_add_pd(a0, a1));
+  for (; i < n; ++i)
+    s += (p[i] - m) * (p[i] - m);
+  return s;
+}
+#endif // SEQUENCE_STATS_X86
+
+kernels select_kernels() {
+  kernels k = {scalar_sum, scalar_min_max, scalar_dot, scalar_sq_dev};
+#ifdef SEQUENCE_STATS_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    kernels wide = {avx512_sum, avx512_min_max, avx512_dot, avx512_sq_dev};
+    k = wide;
+  } else if (__builtin_cpu_supports("avx2")) {
+    kernels wide = {avx2_sum, avx2_min_max, avx2_dot, avx2_sq_dev};
+    k = wide;
+  }
+#endif
+  return k;
+}
+
+// Post: The kernels for this CPU are returned (chosen on the first call;
+//       C++11 makes the initialization of the local static thread-safe).
+const kernels &best_kernels() {
+  static const kernels k = select_kernels();
+  return k;
+}
+} // namespace
+
+namespace CS3358_SP2024 {
+double sum(const sequence &s, bool compensated) {
+  return best_kernels().sum(s.begin(), s.size(), compensated);
+}
+
+double minimum(const sequence &s) {
+  assert(s.size() > 0);
+  double lo, hi;
+  best_kernels().min_max(s.begin(), s.size(), lo, hi);
+  return lo;
+}
+
+double maximum(const sequence &s) {
+  assert(s.size() > 0);
+  double lo, hi;
+  best_kernels().min_max(s.begin(), s.size(), lo, hi);
+  return hi;
+}
+
+double mean(const sequence &s, bool compensated) {
+  assert(s.size() > 0);
+  return sum(s, compensated) / s.size();
+}
+
+double variance(const sequence &s, bool compensated) {
+  assert(s.size() > 0);
+  double m = mean(s, compensated);
+  return best_kernels().sq_dev(s.begin(), s.size(), m, compensated) /
+         s.size();
+}
+
+double dot(const sequence &a, const sequence &b, bool compensated) {
+  assert(a.size() == b.size());
+  return best_kernels().dot(a.begin(), b.begin(), a.size(), compensated);
+}
+} // namespace CS3358_SP2024
@@ -0,0 +1,60 @@
+// FILE: SequenceStats.h
+// FUNCTIONS PROVIDED: numeric reductions over a sequence (part of the
+// namespace CS3358_SP2024)
+//
+// These functions read the items of a sequence straight from its array
+// (through begin() and end()) instead of through start, advance and
+// current, and use the widest SIMD instructions the CPU supports
+// (AVX-512 or AVX2 on x86, picked at run time the first time one of them
+// is called), with plain loops as the fallback everywhere else. None of
+// them changes the sequence or its current item.
+//
+// The vectorized loops add the items in a different order than a plain
+// front-to-back loop does, and floating-point addition is not
+// associative, so results can differ from such a loop in the last few
+// bits. Passing compensated = true uses Kahan (compensated) summation
+// instead, which keeps the rounding error from growing with the number
+// of items, at roughly twice the cost.
+//
+//   double sum(const sequence& s, bool compensated = false)
+//     Pre:  (none)
+//     Post: The sum of the items of s is returned (0 if s is empty).
+//   double minimum(const sequence& s)
+//   double maximum(const sequence& s)
+//     Pre:  s.size() > 0
+//     Post: The smallest (largest) item of s is returned.
+//     Note: The result is unspecified if any item of s is a NaN.
+//   double mean(const sequence& s, bool compensated = false)
+//     Pre:  s.size() > 0
+//     Post: The arithmetic mean of the items of s is returned.
+//   double variance(const sequence& s, bool compensated = false)
+//     Pre:  s.size() > 0
+//     Post: The population variance of the items of s (the mean of the
+//           squared differences from mean(s)) is returned.
+//     Note: Computed in two passes (first the mean, then the squared
+//           differences), which is far more accurate than the one-pass
+//           sum-of-squares formula when the items are large compared to
+//           their spread.
+//   double dot(const sequence& a, const sequence& b,
+//              bool compensated = false)
+//     Pre:  a.size() == b.size()
+//     Post: The dot product of a and b (the sum of the products of their
+//           items at the same positions) is returned (0 if both are
+//           empty).
+
+#ifndef SEQUENCE_STATS_H
+#define SEQUENCE_STATS_H
+#include "Sequence.h"
+
+namespace CS3358_SP2024
+{
+   double sum(const sequence& s, bool compensated = false);
+   double minimum(const sequence& s);
+   double maximum(const sequence& s);
+   double mean(const sequence& s, bool compensated = false);
+   double variance(const sequence& s, bool compensated = false);
+   double dot(const sequence& a, const sequence& b,
+              bool compensated = false);
+}
+
+#endif
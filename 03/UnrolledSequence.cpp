@@ -0,0 +1,408 @@
+// FILE: UnrolledSequence.cpp
+// CLASS IMPLEMENTED: unrolled_sequence (see UnrolledSequence.h for
+// documentation)
+// INVARIANT for the unrolled_sequence ADT:
+//   1. The number of items in the sequence is in the member variable
+//      used;
+//   2. The items are stored in nodes, each holding from 1 to
+//      NODE_CAPACITY items in items[0] through items[count-1]. The nodes
+//      form a doubly linked list (through prev and next) from the member
+//      variable head to the member variable tail, and reading them in
+//      that order gives the items of the sequence in order. An empty
+//      sequence has no nodes (head and tail are 0).
+//   3. If there is more than one node, every node holds at least
+//      MIN_COUNT items.
+//   4. The index of the current item is in the member variable
+//      current_index. If there is no valid current item, then
+//      current_index will be set to the same number as used (see
+//      Sequence.cpp for why this is a good choice). When there is a
+//      current item, it is current_node->items[current_offset];
+//      otherwise current_node and current_offset don't matter.
+
+#include "UnrolledSequence.h"
+#include <cassert>
+#include <stdexcept>
+using namespace std;
+
+namespace CS3358_SP2024 {
+// CONSTRUCTORS and DESTRUCTOR
+unrolled_sequence::unrolled_sequence(size_type initial_capacity)
+    : head(0), tail(0), used(0), current_index(0), current_node(0),
+      current_offset(0) {}
+
+unrolled_sequence::unrolled_sequence(const unrolled_sequence &source)
+    : head(0), tail(0), used(source.used),
+      current_index(source.current_index), current_node(0),
+      current_offset(0) {
+  copy_nodes(source);
+  if (is_item())
+    locate(current_index, current_node, current_offset);
+}
+
+unrolled_sequence::~unrolled_sequence() { destroy(head); }
+
+// MODIFICATION MEMBER FUNCTIONS
+void unrolled_sequence::resize(size_type new_capacity) {
+  // Storage is allocated a node at a time; there's no capacity to change.
+}
+
+void unrolled_sequence::start() {
+  current_index = 0;
+  current_node = head;
+  current_offset = 0;
+}
+
+void unrolled_sequence::advance() {
+  if (is_item()) {
+    ++current_index;
+    if (++current_offset == current_node->count && current_node->next != 0) {
+      current_node = current_node->next;
+      current_offset = 0;
+    }
+  }
+}
+
+void unrolled_sequence::insert(const value_type &entry) {
+  if (!is_item()) {
+    current_index = 0;
+    insert_at(head, 0, entry);
+  } else {
+    insert_at(current_node, current_offset, entry);
+  }
+}
+
+void unrolled_sequence::attach(const value_type &entry) {
+  if (!is_item()) {
+    current_index = used;
+    insert_at(tail, tail != 0 ? tail->count : 0, entry);
+  } else {
+    ++current_index;
+    insert_at(current_node, current_offset + 1, entry);
+  }
+}
+
+void unrolled_sequence::remove_current() {
+  if (is_item()) {
+    node *n = current_node;
+    for (size_type i = current_offset + 1; i < n->count; ++i)
+      n->items[i - 1] = n->items[i];
+    --n->count;
+    --used;
+
+    // The cursor stays at (n, current_offset), which is now the item
+    // after the removed one (or just past n's items).
+    if (n->count < MIN_COUNT)
+      rebalance(n);
+    fix_cursor();
+  }
+}
+
+unrolled_sequence unrolled_sequence::split_at_cursor() {
+  unrolled_sequence rest;
+  if (!is_item())
+    return rest;
+  node *first =
+      current_offset > 0 ? cut(current_node, current_offset) : current_node;
+
+  rest.head = first;
+  rest.tail = tail;
+  tail = first->prev;
+  (tail != 0 ? tail->next : head) = 0;
+  first->prev = 0;
+  rest.used = used - current_index;
+  used = current_index;
+  rest.current_node = first;
+
+  // Cutting may have left a node on either side too small.
+  if (first->count < MIN_COUNT)
+    rest.rebalance(first);
+  if (tail != 0 && tail->count < MIN_COUNT)
+    rebalance(tail);
+  return rest;
+}
+
+void unrolled_sequence::splice(unrolled_sequence &other) {
+  assert(&other != this);
+  if (other.used == 0)
+    return;
+  // other's nodes go between left and right (either may be 0).
+  bool had_item = is_item();
+  node *left, *right;
+  if (!had_item) {
+    left = tail;
+    right = 0;
+  } else if (current_offset == 0) {
+    right = current_node;
+    left = right->prev;
+  } else {
+    left = current_node;
+    right = cut(current_node, current_offset);
+  }
+
+  node *first = other.head, *last = other.tail;
+  first->prev = left;
+  (left != 0 ? left->next : head) = first;
+  last->next = right;
+  (right != 0 ? right->prev : tail) = last;
+  used += other.used;
+  if (had_item) {
+    current_node = right;
+    current_offset = 0;
+    current_index += other.used;
+  } else {
+    current_index = used;
+  }
+  other.head = other.tail = other.current_node = 0;
+  other.used = other.current_index = other.current_offset = 0;
+
+  // Only the two halves of a cut node, or other's only node, can be too
+  // small. They are fixed from right to left, since rebalancing a node
+  // deletes only that node or the one after it, neither of which is
+  // looked at again.
+  if (right != 0 && right->count < MIN_COUNT)
+    rebalance(right);
+  if (last->count < MIN_COUNT)
+    rebalance(last);
+  if (left != 0 && left->count < MIN_COUNT)
+    rebalance(left);
+}
+
+unrolled_sequence &
+unrolled_sequence::operator=(const unrolled_sequence &source) {
+  if (this != &source) {
+    node *old_head = head;
+    copy_nodes(source);
+    destroy(old_head);
+    used = source.used;
+    current_index = source.current_index;
+    if (is_item())
+      locate(current_index, current_node, current_offset);
+  }
+  return *this;
+}
+
+// CONSTANT MEMBER FUNCTIONS
+unrolled_sequence::size_type unrolled_sequence::size() const { return used; }
+
+bool unrolled_sequence::is_item() const { return current_index < used; }
+
+unrolled_sequence::value_type unrolled_sequence::current() const {
+  if (!is_item()) {
+    throw std::logic_error("No current item in the sequence.");
+  }
+  return current_node->items[current_offset];
+}
+
+const unrolled_sequence::value_type &
+unrolled_sequence::operator[](size_type index) const {
+  assert(index < used);
+  node *n;
+  size_type offset;
+  locate(index, n, offset);
+  return n->items[offset];
+}
+
+unrolled_sequence::const_iterator unrolled_sequence::begin() const {
+  return const_iterator(head, 0);
+}
+
+unrolled_sequence::const_iterator unrolled_sequence::end() const {
+  return const_iterator(tail, tail != 0 ? tail->count : 0);
+}
+
+// HELPER MEMBER FUNCTIONS
+// Pre:  index < used
+// Post: n->items[offset] is the item at position index, found by walking
+//       the list from whichever end is nearer.
+void unrolled_sequence::locate(size_type index, node *&n,
+                               size_type &offset) const {
+  assert(index < used);
+  if (index < used / 2) {
+    n = head;
+    while (index >= n->count) {
+      index -= n->count;
+      n = n->next;
+    }
+    offset = index;
+  } else {
+    size_type from_end = used - index;
+    n = tail;
+    while (from_end > n->count) {
+      from_end -= n->count;
+      n = n->prev;
+    }
+    offset = n->count - from_end;
+  }
+}
+
+// Pre:  n is a node of the list and offset <= n->count, or the sequence
+//       is empty and n is 0.
+// Post: entry has been inserted before n->items[offset] (after n's last
+//       item if offset is n->count), splitting n first if it was full,
+//       and current_node and current_offset point at it; the caller sets
+//       current_index.
+void unrolled_sequence::insert_at(node *n, size_type offset,
+                                  const value_type &entry) {
+  // Copied first: entry may refer into a node (through operator[]), and
+  // cut may move it.
+  value_type item = entry;
+  if (n == 0) {
+    n = new node;
+    n->count = 0;
+    n->prev = n->next = 0;
+    head = tail = n;
+  } else if (n->count == NODE_CAPACITY) {
+    node *right = cut(n, NODE_CAPACITY / 2);
+    if (offset > n->count) {
+      offset -= n->count;
+      n = right;
+    }
+  }
+
+  for (size_type i = n->count; i > offset; --i)
+    n->items[i] = n->items[i - 1];
+  n->items[offset] = item;
+  ++n->count;
+  ++used;
+  current_node = n;
+  current_offset = offset;
+}
+
+// Pre:  n is a node of the list and 0 < offset < n->count
+// Post: n's items from items[offset] on have been moved into a new node,
+//       which has been linked into the list after n and returned.
+unrolled_sequence::node *unrolled_sequence::cut(node *n, size_type offset) {
+  node *right = new node;
+  right->count = n->count - offset;
+  for (size_type i = 0; i < right->count; ++i)
+    right->items[i] = n->items[offset + i];
+  n->count = offset;
+
+  right->prev = n;
+  right->next = n->next;
+  (n->next != 0 ? n->next->prev : tail) = right;
+  n->next = right;
+  return right;
+}
+
+// Pre:  n is a node of the list holding fewer than MIN_COUNT items.
+// Post: If n is empty, it has been removed from the list; otherwise, if
+//       n isn't the only node, it has been merged with the next node
+//       (or the previous one, if n is the tail) if the two fit in one
+//       node, or else items have been moved between them to even them
+//       out (so both then hold more than NODE_CAPACITY / 2). Only n, or
+//       the node after it, may have been deleted. current_node and
+//       current_offset still point at the same item, or (if they pointed
+//       just past the last item of one of the two nodes) still just past
+//       the same item.
+void unrolled_sequence::rebalance(node *n) {
+  if (n->count == 0) {
+    (n->prev != 0 ? n->prev->next : head) = n->next;
+    (n->next != 0 ? n->next->prev : tail) = n->prev;
+    if (current_node == n) {
+      current_node = n->next;
+      current_offset = 0;
+    }
+    delete n;
+    return;
+  }
+  if (n->prev == 0 && n->next == 0)
+    return;
+
+  node *left = n->next != 0 ? n : n->prev;
+  node *right = left->next;
+  if (left->count + right->count <= NODE_CAPACITY) {
+    if (current_node == right) {
+      current_node = left;
+      current_offset += left->count;
+    }
+    for (size_type i = 0; i < right->count; ++i)
+      left->items[left->count + i] = right->items[i];
+    left->count += right->count;
+    left->next = right->next;
+    (right->next != 0 ? right->next->prev : tail) = left;
+    delete right;
+  } else if (left == n) {
+    // Move the first k items of right to the end of left.
+    size_type k = (right->count - left->count) / 2;
+    if (current_node == right) {
+      if (current_offset < k) {
+        current_node = left;
+        current_offset += left->count;
+      } else {
+        current_offset -= k;
+      }
+    }
+    for (size_type i = 0; i < k; ++i)
+      left->items[left->count + i] = right->items[i];
+    for (size_type i = k; i < right->count; ++i)
+      right->items[i - k] = right->items[i];
+    left->count += k;
+    right->count -= k;
+  } else {
+    // Move the last k items of left to the front of right.
+    size_type k = (left->count - right->count) / 2;
+    size_type keep = left->count - k;
+    if (current_node == right) {
+      current_offset += k;
+    } else if (current_node == left && current_offset >= keep) {
+      current_node = right;
+      current_offset -= keep;
+    }
+    for (size_type i = right->count; i > 0; --i)
+      right->items[i - 1 + k] = right->items[i - 1];
+    for (size_type i = 0; i < k; ++i)
+      right->items[i] = left->items[keep + i];
+    left->count = keep;
+    right->count += k;
+  }
+}
+
+// Pre:  current_node and current_offset point at the current item, or
+//       just past the last item of current_node.
+// Post: In the latter case they now point at the first item of the next
+//       node, if there is one (invariant 4).
+void unrolled_sequence::fix_cursor() {
+  if (current_node != 0 && current_offset == current_node->count &&
+      current_node->next != 0) {
+    current_node = current_node->next;
+    current_offset = 0;
+  }
+}
+
+// Pre:  (none)
+// Post: head and tail describe a new list of nodes holding a copy of
+//       source's items, node for node (the old list is left as is). If
+//       an allocation fails, the nodes copied so far have been deleted
+//       and head and tail are unchanged.
+void unrolled_sequence::copy_nodes(const unrolled_sequence &source) {
+  node *new_head = 0, *new_tail = 0;
+  try {
+    for (const node *s = source.head; s != 0; s = s->next) {
+      node *n = new node;
+      n->count = s->count;
+      for (size_type i = 0; i < s->count; ++i)
+        n->items[i] = s->items[i];
+      n->prev = new_tail;
+      n->next = 0;
+      (new_tail != 0 ? new_tail->next : new_head) = n;
+      new_tail = n;
+    }
+  } catch (...) {
+    destroy(new_head);
+    throw;
+  }
+  head = new_head;
+  tail = new_tail;
+}
+
+// Pre:  first is the head of a list of nodes (or 0).
+// Post: All the nodes of the list have been deleted.
+void unrolled_sequence::destroy(node *first) {
+  while (first != 0) {
+    node *next = first->next;
+    delete first;
+    first = next;
+  }
+}
+} // namespace CS3358_SP2024
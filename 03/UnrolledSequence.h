@@ -0,0 +1,156 @@
+// FILE: UnrolledSequence.h
+// CLASS PROVIDED: unrolled_sequence (part of the namespace CS3358_SP2024)
+//
+// unrolled_sequence provides the same interface (typedefs, constants,
+// constructors and member functions) as rope_sequence (see
+// RopeSequence.h), including split_at_cursor and splice, and the same
+// documentation applies; simply replace rope_sequence with
+// unrolled_sequence. Again only the storage (and so the cost of the
+// operations) differs:
+//
+//   The items are kept in an unrolled linked list: a doubly linked list
+//   of nodes, each an array of up to NODE_CAPACITY items (2KB of
+//   doubles). Every node holds from NODE_CAPACITY / 4 to NODE_CAPACITY
+//   items (64 to 256), except that a sequence with a single node may
+//   hold fewer. A full node is split in two halves when an item is
+//   inserted into it, and a node that drops below a quarter full is
+//   merged with a neighbour (or takes items from it, if the two don't
+//   fit in one node).
+//
+//   The cursor knows its node, so insert, attach and remove_current
+//   only shift items within one node: O(NODE_CAPACITY), whatever the
+//   size of the sequence. start and advance are O(1), and advance scans
+//   each node's array contiguously, almost as fast as for sequence.
+//   There is no index over the nodes (unlike rope_sequence), so
+//   operator[] walks the list from the nearer end, node by node:
+//   O(n / NODE_CAPACITY). This suits sequences of moderate size (up to
+//   some hundreds of thousands of items) edited mostly at the cursor.
+//
+//   split_at_cursor and splice relink nodes without copying their items
+//   (at most the cursor's node is cut in two, and a node left under a
+//   quarter full at a seam is merged or rebalanced with a neighbour),
+//   so both are O(NODE_CAPACITY), independent of the number of items.
+//
+//   As for rope_sequence, storage grows and shrinks a node at a time:
+//   initial_capacity (constructor) and new_capacity (resize) have no
+//   effect. unrolled_sequence::const_iterator walks the node list, so it
+//   is only bidirectional, but ++ and -- are O(1).
+//
+// VALUE SEMANTICS for the unrolled_sequence class:
+//   Assignments and the copy constructor may be used with
+//   unrolled_sequence objects.
+
+#ifndef UNROLLED_SEQUENCE_H
+#define UNROLLED_SEQUENCE_H
+#include <cstddef>  // provides ptrdiff_t
+#include <cstdlib>  // provides size_t
+#include <iterator> // provides bidirectional_iterator_tag
+
+namespace CS3358_SP2024
+{
+   class unrolled_sequence
+   {
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef double value_type;
+      typedef std::size_t size_type;
+      static const size_type DEFAULT_CAPACITY = 30;
+      static const size_type NODE_CAPACITY = 2048 / sizeof(value_type);
+      class const_iterator;
+      // CONSTRUCTORS and DESTRUCTOR
+      unrolled_sequence(size_type initial_capacity = DEFAULT_CAPACITY);
+      unrolled_sequence(const unrolled_sequence& source);
+      ~unrolled_sequence();
+      // MODIFICATION MEMBER FUNCTIONS
+      void resize(size_type new_capacity);
+      void start();
+      void advance();
+      void insert(const value_type& entry);
+      void attach(const value_type& entry);
+      void remove_current();
+      unrolled_sequence split_at_cursor();
+      void splice(unrolled_sequence& other);
+      unrolled_sequence& operator=(const unrolled_sequence& source);
+      // CONSTANT MEMBER FUNCTIONS
+      size_type size() const;
+      bool is_item() const;
+      value_type current() const;
+      const value_type& operator[](size_type index) const;
+      const_iterator begin() const;
+      const_iterator end() const;
+   private:
+      // The fewest items a node may hold (unless it is the only one).
+      static const size_type MIN_COUNT = NODE_CAPACITY / 4;
+      struct node
+      {
+         value_type items[NODE_CAPACITY];
+         size_type count;
+         node* prev;
+         node* next;
+      };
+      node* head;
+      node* tail;
+      size_type used;
+      size_type current_index;
+      node* current_node;
+      size_type current_offset;
+      // HELPER MEMBER FUNCTIONS
+      void locate(size_type index, node*& n, size_type& offset) const;
+      void insert_at(node* n, size_type offset, const value_type& entry);
+      node* cut(node* n, size_type offset);
+      void rebalance(node* n);
+      void fix_cursor();
+      void copy_nodes(const unrolled_sequence& source);
+      static void destroy(node* first);
+   };
+
+   // An iterator is a (node, offset) pair, like current_node and
+   // current_offset; end() is the position just past the last item of
+   // the last node (or a null node, for an empty sequence).
+   class unrolled_sequence::const_iterator
+   {
+   public:
+      typedef std::bidirectional_iterator_tag iterator_category;
+      typedef unrolled_sequence::value_type value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const value_type* pointer;
+      typedef const value_type& reference;
+      const_iterator() : n(0), offset(0) {}
+      reference operator*() const { return n->items[offset]; }
+      pointer operator->() const { return &n->items[offset]; }
+      const_iterator& operator++()
+      {
+         if (++offset == n->count && n->next != 0)
+         {
+            n = n->next;
+            offset = 0;
+         }
+         return *this;
+      }
+      const_iterator& operator--()
+      {
+         if (offset == 0)
+         {
+            n = n->prev;
+            offset = n->count;
+         }
+         --offset;
+         return *this;
+      }
+      const_iterator operator++(int)
+         { const_iterator old = *this; ++*this; return old; }
+      const_iterator operator--(int)
+         { const_iterator old = *this; --*this; return old; }
+      bool operator==(const const_iterator& other) const
+         { return n == other.n && offset == other.offset; }
+      bool operator!=(const const_iterator& other) const
+         { return !(*this == other); }
+   private:
+      friend class unrolled_sequence;
+      const_iterator(const node* p, size_type o) : n(p), offset(o) {}
+      const node* n;
+      size_type offset;
+   };
+}
+
+#endif
@@ -21,12 +21,26 @@
 //     track of how many items are in a sequence.
 //   static const size_type CAPACITY = _____
 //     sequence::CAPACITY is the maximum number of items that a
-//     sequence can hold.
+//     sequence can hold. It is the second template parameter, N, so
+//     Sequence<T, N> holds up to N items (Sequence<T> holds up to 10).
+//   typedef ____ const_iterator
+//     sequence::const_iterator is a random-access iterator over the items
+//     of a sequence that can't be used to change them. Any number of
+//     iterators may traverse a sequence at once, independently of each
+//     other and of the sequence's current item.
+//
+// The items are kept in a fixed array of CAPACITY items used as a
+// circular buffer, so adding or removing an item at either end of the
+// sequence is O(1), and any other add or remove moves only the items on
+// the shorter side of it.
 //
 // CONSTRUCTOR for the sequence class:
 //   sequence()
 //     Pre:  (none)
 //     Post: The sequence has been initialized as an empty sequence.
+//     Note: The constructor, size and is_item are constexpr, so a
+//           sequence of a literal type (such as int or double) can be
+//           constant-initialized (e.g. as a global or static object).
 //
 // MODIFICATION MEMBER FUNCTIONS for the sequence class:
 //   void start()
@@ -61,6 +75,71 @@
 //           the item after this (if there is one) is now the new current
 //           item. If the current item was already the last item in the
 //           sequence, then there is no longer any current item.
+//   void insert_range(const value_type items[], size_type count)
+//     Pre:  size() + count <= CAPACITY, and items points to at least
+//           count items (it may be 0 if count is 0).
+//     Post: Copies of items[0] through items[count-1] have been inserted,
+//           in that order, before the current item. If there was no
+//           current item, then they have been inserted at the front of
+//           the sequence. Unless count is 0, the copy of items[0] is now
+//           the current item.
+//   void attach_range(const value_type items[], size_type count)
+//     Pre:  size() + count <= CAPACITY, and items points to at least
+//           count items (it may be 0 if count is 0).
+//     Post: Copies of items[0] through items[count-1] have been inserted,
+//           in that order, after the current item. If there was no
+//           current item, then they have been inserted as the new first
+//           items of the sequence. Unless count is 0, the copy of
+//           items[count-1] is now the current item.
+//     Note: The result is the same as calling add for items[0],
+//           items[1], ..., items[count-1] (in that order), but the
+//           existing items are shifted only once.
+//   void erase_range(size_type count)
+//     Pre:  is_item() returns true.
+//     Post: The current item and the count-1 items after it (or as many
+//           of them as there are) have been removed from the sequence,
+//           and the item after the last one removed (if there is one) is
+//           now the new current item; otherwise there is no longer any
+//           current item.
+//   void seek_lower_bound(const value_type& target)
+//     Pre:  The items are in non-decreasing order (operator< is used to
+//           compare them).
+//     Post: The first item that is not less than target (if there is
+//           one) is now the current item; otherwise there is no longer
+//           any current item. The items are unchanged.
+//     Note: Uses a binary search (O(log n), unlike a start/advance scan).
+//   void insert_sorted(const value_type& entry)
+//     Pre:  size() < CAPACITY, and the items are in non-decreasing order.
+//     Post: A new copy of entry has been inserted after the last item
+//           that is not greater than it (so after any items equal to
+//           it), keeping the items in non-decreasing order, and the
+//           newly inserted item is now the current item of the sequence.
+//   void sort()
+//     Pre:  (none)
+//     Post: The items have been rearranged into non-decreasing order
+//           (using operator<), and the first item (if there is one) is
+//           now the current item.
+//     Note: The items are rotated to the start of the array, then sorted
+//           in place with std::sort (an introsort, O(n log n)), except
+//           in a Sequence<double, N>: that is radix sorted (O(n)), one
+//           byte of each item at a time, through a scratch array from
+//           the heap, so its items must not be NaN and -0.0 is put
+//           before 0.0. If there is no room for the scratch array,
+//           std::sort is used after all.
+//   template <typename Predicate> size_type remove_if(Predicate pred)
+//     Pre:  pred can be called with a const value_type& and returns
+//           something convertible to bool, and doesn't change the
+//           sequence.
+//     Post: Every item for which pred returned true has been removed
+//           from the sequence, and the remaining items keep their order.
+//           The return value is the number of items removed. If the
+//           current item was kept, it is still the current item; if it
+//           was removed, the first remaining item after it (if there is
+//           one) is now the new current item, as for remove_current;
+//           otherwise there is no longer any current item.
+//     Note: pred is called once for each item, front to back, and the
+//           remaining items are moved at most once each (O(n), unlike
+//           calling remove_current for each item to be removed).
 //
 // CONSTANT MEMBER FUNCTIONS for the sequence class:
 //   size_type size() const
@@ -75,6 +154,72 @@
 //   value_type current() const
 //     Pre:  is_item() returns true.
 //     Post: The item returned is the current item in the sequence.
+//   const value_type& operator[](size_type index) const
+//     Pre:  index < size()
+//     Post: The item at position index (counting from 0 at the front of
+//           the sequence) is returned. The current item is unchanged.
+//   const_iterator cbegin() const
+//   const_iterator cend() const
+//     Pre:  (none)
+//     Post: An iterator to the first item of the sequence, or just past
+//           its last item, is returned (the two are equal for an empty
+//           sequence). The current item is unchanged.
+//     Note: These are named cbegin and cend (not begin and end) since
+//           end() already moves the current item to the end.
+//     Note: References returned by operator[] and iterators returned by
+//           cbegin and cend remain valid only until the sequence is next
+//           modified.
+//
+// SPECIALIZATION for sequences of characters (Sequence<char, N>):
+//   A sequence of char (seqChar) keeps its items in one contiguous,
+//   growable array instead of the fixed circular buffer, so it has no
+//   size limit (CAPACITY is the largest size_type) and N is only the
+//   room set aside when the first item is added. It provides all of the
+//   functions above, except that const_iterator is simply const char*,
+//   and the constructor is constexpr but, as it owns dynamic memory, a
+//   seqChar is not a literal type. Adding an item in the middle moves
+//   the items after it (not whichever side is shorter); adding at the
+//   end is amortized O(1). sort is a counting sort (O(n)). It also
+//   provides:
+//   Sequence(memory_resource* resource)
+//     Pre:  resource (if not 0) outlives the sequence.
+//     Post: The sequence is empty, and its storage will be allocated
+//           from resource (see ../03/MemoryResource.h), or from the heap
+//           if resource is 0 (as with the default constructor).
+//     Note: As for the 03 sequence, a copy uses the same resource as
+//           the original, a sequence moved from another takes over the
+//           other's resource along with its storage, and a sequence
+//           assigned to (copy assignment) keeps its own resource. Using
+//           a monotonic_arena means linking in ../03/MemoryResource.cpp.
+//   memory_resource* get_resource() const
+//     Pre:  (none)
+//     Post: The return value is the resource the storage is allocated
+//           from (0 for the heap).
+//   void append(const char* text)
+//     Pre:  text points to a null-terminated string.
+//     Post: The characters of text (not the null) have been added, in
+//           order, at the end of the sequence. The current item is
+//           unchanged (if there was no current item, there still isn't).
+//     Note: The characters are copied in one go, so this is far cheaper
+//           than adding them one at a time.
+//   bool find(char target)
+//     Pre:  (none)
+//     Post: If target occurs at or after the current item, its first
+//           such occurrence is now the current item and the return value
+//           is true. Otherwise there is no longer any current item and
+//           the return value is false (so if there was no current item,
+//           nothing is searched; call start first to search the whole
+//           sequence).
+//   bool find(const char* text)
+//     Pre:  text points to a null-terminated string.
+//     Post: As for find(char), but for the first occurrence of the
+//           characters of text (in order, one after another) that
+//           begins at or after the current item; the current item is
+//           then the first character of that occurrence. If text is
+//           empty it matches at the current item (if there is one).
+//     Note: Both searches compare 16 characters at a time (SSE2 on
+//           x86-64). To find every occurrence, advance after each match
+//           before searching again.
 // VALUE SEMANTICS for the sequence class:
 //    Assignments and the copy constructor may be used with sequence
 //    objects.
@@ -82,17 +227,25 @@
 #ifndef SEQUENCE_H
 #define SEQUENCE_H
 
-#include <cstdlib> // provides size_t
+#include <cstddef>     // provides ptrdiff_t
+#include <cstdint>     // provides uint64_t
+#include <cstdlib>     // provides size_t
+#include <iterator>    // provides random_access_iterator_tag
+#include <type_traits> // provides false_type, is_same, true_type
+#include "../03/MemoryResource.h" // provides memory_resource
 
 namespace CS3358_SP2024_A04 {
-template <typename T> class Sequence {
+using CS3358_SP2024::memory_resource;
+
+template <typename T, size_t N = 10> class Sequence {
 public:
   // TYPEDEFS and MEMBER CONSTANTS
   typedef T value_type;
   typedef size_t size_type;
-  static const size_type CAPACITY = 10;
+  static const size_type CAPACITY = N;
+  class const_iterator;
   // CONSTRUCTOR
-  Sequence();
+  constexpr Sequence();
   // MODIFICATION MEMBER FUNCTIONS
   void start();
   void end();
@@ -100,16 +253,168 @@ public:
   void move_back();
   void add(const value_type &entry);
   void remove_current();
+  void insert_range(const value_type items[], size_type count);
+  void attach_range(const value_type items[], size_type count);
+  void erase_range(size_type count);
+  void seek_lower_bound(const value_type &target);
+  void insert_sorted(const value_type &entry);
+  void sort();
+  template <typename Predicate> size_type remove_if(Predicate pred);
   // CONSTANT MEMBER FUNCTIONS
-  size_type size() const;
-  bool is_item() const;
+  constexpr size_type size() const;
+  constexpr bool is_item() const;
   value_type current() const;
+  const value_type &operator[](size_type index) const;
+  const_iterator cbegin() const;
+  const_iterator cend() const;
 
 private:
   value_type data[CAPACITY];
+  size_type head;
+  size_type used;
+  size_type current_index;
+  // HELPER MEMBER FUNCTIONS
+  size_type slot(size_type index) const;
+  void make_gap(size_type index, size_type count);
+  void close_gap(size_type index, size_type count);
+  static void sort_items(value_type *a, size_type n, std::false_type);
+  static void sort_items(value_type *a, size_type n, std::true_type);
+  static std::uint64_t radix_key(double x);
+};
+
+// An iterator is a (sequence, position) pair; dereferencing it maps the
+// position into the circular buffer, as operator[] does.
+template <typename T, size_t N> class Sequence<T, N>::const_iterator {
+public:
+  typedef std::random_access_iterator_tag iterator_category;
+  typedef T value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef const T *pointer;
+  typedef const T &reference;
+  const_iterator() : seq(0), index(0) {}
+  reference operator*() const { return (*seq)[index]; }
+  pointer operator->() const { return &(*seq)[index]; }
+  reference operator[](difference_type n) const { return (*seq)[index + n]; }
+  const_iterator &operator++() {
+    ++index;
+    return *this;
+  }
+  const_iterator &operator--() {
+    --index;
+    return *this;
+  }
+  const_iterator operator++(int) {
+    const_iterator old = *this;
+    ++index;
+    return old;
+  }
+  const_iterator operator--(int) {
+    const_iterator old = *this;
+    --index;
+    return old;
+  }
+  const_iterator &operator+=(difference_type n) {
+    index += n;
+    return *this;
+  }
+  const_iterator &operator-=(difference_type n) {
+    index -= n;
+    return *this;
+  }
+  const_iterator operator+(difference_type n) const {
+    return const_iterator(seq, index + n);
+  }
+  const_iterator operator-(difference_type n) const {
+    return const_iterator(seq, index - n);
+  }
+  difference_type operator-(const const_iterator &other) const {
+    return difference_type(index) - difference_type(other.index);
+  }
+  bool operator==(const const_iterator &other) const {
+    return index == other.index;
+  }
+  bool operator!=(const const_iterator &other) const {
+    return index != other.index;
+  }
+  bool operator<(const const_iterator &other) const {
+    return index < other.index;
+  }
+  bool operator>(const const_iterator &other) const {
+    return index > other.index;
+  }
+  bool operator<=(const const_iterator &other) const {
+    return index <= other.index;
+  }
+  bool operator>=(const const_iterator &other) const {
+    return index >= other.index;
+  }
+
+private:
+  friend class Sequence;
+  const_iterator(const Sequence *s, size_type i) : seq(s), index(i) {}
+  const Sequence *seq;
+  size_type index;
+};
+
+// The char specialization (see SPECIALIZATION above).
+template <size_t N> class Sequence<char, N> {
+public:
+  // TYPEDEFS and MEMBER CONSTANTS
+  typedef char value_type;
+  typedef size_t size_type;
+  static const size_type CAPACITY = size_type(-1);
+  typedef const char *const_iterator;
+  // CONSTRUCTORS and DESTRUCTOR
+  constexpr Sequence();
+  explicit constexpr Sequence(memory_resource *resource);
+  Sequence(const Sequence &source);
+  Sequence(Sequence &&source) noexcept;
+  ~Sequence();
+  // MODIFICATION MEMBER FUNCTIONS
+  void start();
+  void end();
+  void advance();
+  void move_back();
+  void add(const value_type &entry);
+  void remove_current();
+  void insert_range(const value_type items[], size_type count);
+  void attach_range(const value_type items[], size_type count);
+  void erase_range(size_type count);
+  void seek_lower_bound(const value_type &target);
+  void insert_sorted(const value_type &entry);
+  void sort();
+  template <typename Predicate> size_type remove_if(Predicate pred);
+  void append(const char *text);
+  bool find(char target);
+  bool find(const char *text);
+  Sequence &operator=(const Sequence &source);
+  Sequence &operator=(Sequence &&source) noexcept;
+  // CONSTANT MEMBER FUNCTIONS
+  constexpr size_type size() const;
+  constexpr bool is_item() const;
+  value_type current() const;
+  const value_type &operator[](size_type index) const;
+  const_iterator cbegin() const;
+  const_iterator cend() const;
+  memory_resource *get_resource() const;
+
+private:
+  char *data;
+  size_type capacity;
   size_type used;
   size_type current_index;
+  memory_resource *resource;
+  // HELPER MEMBER FUNCTIONS
+  char *allocate(size_type bytes) const;
+  void deallocate(char *p, size_type bytes) const;
+  void make_gap(size_type index, size_type count);
+  void close_gap(size_type index, size_type count);
+  static size_type search(const char *text, size_type length,
+                          const char *pattern, size_type pattern_length);
 };
+
+typedef Sequence<double> seqDouble;
+typedef Sequence<char> seqChar;
 } // namespace CS3358_SP2024_A04
 
 #include "sequence.template"
@@ -0,0 +1,502 @@
+// FILE: sequenceFuzz.cpp
+//       A non-interactive differential test program for Sequence<T, N>
+//       and seqChar.
+//
+// DESCRIPTION:
+// Sequences are put through a long series of random operations, and
+// after each one they are checked against a model (a vector of the
+// items and the position of the current item) that does the same thing
+// the simple way. Fixed sequences of double (N = 1, 10, 64, and 300 so
+// that sort takes the radix path), int and std::string (which isn't
+// trivially copyable) are tested, so that the ring buffer wraps around
+// in every way, and so are seqChar and Sequence<char, 0>. The operations cover the cursor functions, add and
+// remove_current, the range functions, seek_lower_bound and
+// insert_sorted, sort, remove_if, copying and (for seqChar) moving,
+// append and both finds. Items are compared bit for bit, so -0.0 can't
+// pass for 0.0.
+//
+// The seqChar sequences are allocated from the heap, from a tracking
+// resource, which checks each deallocation against what it allocated
+// and that nothing is left at the end, and from a monotonic_arena, and
+// are checked to carry their resource as sequence.h says.
+//
+// USAGE:
+//   a4fuzz [operations [seed]]
+// Runs the given number of operations (default 100000) on each kind of
+// sequence. Prints the number of operations checked and "passed", or
+// the first operation that went wrong and "FAILED"; the exit status is
+// EXIT_SUCCESS only if it passed. Building it with
+// -fsanitize=address,undefined also catches what the checks can't see.
+
+#include "sequence.h"
+#include "../03/MemoryResource.h"
+#include <algorithm> // provides lower_bound, search, sort, stable_sort,
+                     // upper_bound
+#include <cstdint>   // provides uint64_t
+#include <cstdlib>   // provides atol, exit, EXIT_SUCCESS, EXIT_FAILURE
+#include <cstring>   // provides memcmp, memcpy, strlen
+#include <iostream>  // provides cout
+#include <map>
+#include <random>  // provides mt19937_64
+#include <string>
+#include <utility> // provides make_pair, move, pair
+#include <vector>
+using namespace std;
+using namespace CS3358_SP2024_A04;
+using CS3358_SP2024::monotonic_arena;
+
+// Constant initialization of a sequence of a literal type.
+constexpr Sequence<double, 4> EMPTY_SEQUENCE;
+static_assert(EMPTY_SEQUENCE.size() == 0 && !EMPTY_SEQUENCE.is_item(),
+              "a constexpr sequence starts out empty");
+
+// The most items added by one range operation.
+const size_t MAX_RANGE = 20;
+// A seqChar with more items than this is cut in half.
+const size_t MAX_CHARS = 2000;
+
+// What a sequence should hold: its items, and the position of its
+// current item (items.size() if there is none).
+template <typename T> struct model {
+  vector<T> items;
+  size_t current;
+  model() : current(0) {}
+};
+
+// The blocks handed out by a tracking_resource, and the number of bad
+// deallocations seen.
+struct block_record {
+  map<void *, pair<size_t, size_t>> live;
+  size_t errors;
+  block_record() : errors(0) {}
+};
+
+// A resource that checks every deallocation against what it allocated.
+class tracking_resource : public memory_resource {
+public:
+  explicit tracking_resource(block_record *record) : record(record) {}
+
+private:
+  block_record *record;
+  void *do_allocate(size_t bytes, size_t alignment) {
+    void *p = ::operator new(bytes);
+    record->live[p] = make_pair(bytes, alignment);
+    return p;
+  }
+  void do_deallocate(void *p, size_t bytes, size_t alignment) {
+    map<void *, pair<size_t, size_t>>::iterator it = record->live.find(p);
+    if (it == record->live.end() || it->second.first != bytes ||
+        it->second.second != alignment) {
+      ++record->errors;
+      return;
+    }
+    record->live.erase(it);
+    ::operator delete(p);
+  }
+  bool do_is_equal(const memory_resource &other) const {
+    return this == &other;
+  }
+};
+
+static mt19937_64 rng;
+static const char *sequence_name = "";
+static size_t op_number = 0;
+static const char *op_name = "";
+
+size_t pick(size_t n) { return n == 0 ? 0 : size_t(rng() % n); }
+
+void fail(const char *what) {
+  cout << sequence_name << ", operation " << op_number << " (" << op_name
+       << "): " << what << endl
+       << "FAILED" << endl;
+  exit(EXIT_FAILURE);
+}
+
+// Random items: few different ones, so that many are equal.
+void pick_item(double &x) {
+  if (pick(16) == 0)
+    x = pick(2) ? -0.0 : 0.0;
+  else
+    x = double(int(pick(41)) - 20) / 2;
+}
+void pick_item(int &x) { x = int(pick(21)) - 10; }
+void pick_item(string &x) { x = string(pick(3), char('a' + pick(2))); }
+// Mostly letters, but also a null and chars of both signs.
+void pick_item(char &x) {
+  const char chars[] = {'a', 'b', 'c', 'a', 'b', 'c', '\0', '\x7f', '\x80',
+                        '\xff'};
+  x = chars[pick(sizeof(chars))];
+}
+
+template <typename T> bool same_item(const T &a, const T &b) {
+  return a == b;
+}
+bool same_item(const double &a, const double &b) {
+  return memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+// The order Sequence<double, N>::sort puts items in: as by <, but with
+// -0.0 before 0.0.
+uint64_t sort_key(double x) {
+  const uint64_t sign = uint64_t(1) << 63;
+  uint64_t bits;
+  memcpy(&bits, &x, sizeof(bits));
+  return (bits & sign) ? ~bits : (bits | sign);
+}
+bool key_less(double a, double b) { return sort_key(a) < sort_key(b); }
+
+template <typename T> void sort_model(vector<T> &items) {
+  sort(items.begin(), items.end());
+}
+void sort_model(vector<double> &items) {
+  stable_sort(items.begin(), items.end(), key_less);
+}
+
+// Pre:  none
+// Post: s has been checked against m, and the program has stopped if
+//       they differ.
+template <typename T, size_t N>
+void check(const Sequence<T, N> &s, const model<T> &m) {
+  size_t n = m.items.size();
+  if (s.size() != n)
+    fail("wrong size");
+  if (s.is_item() != (m.current < n))
+    fail("wrong is_item");
+  if (m.current < n && !same_item(s.current(), m.items[m.current]))
+    fail("wrong current item");
+  if (s.cend() - s.cbegin() != ptrdiff_t(n))
+    fail("cbegin to cend is not size() items");
+  size_t i = 0;
+  for (typename Sequence<T, N>::const_iterator it = s.cbegin();
+       it != s.cend(); ++it, ++i)
+    if (!same_item(*it, m.items[i]) || !same_item(s[i], m.items[i]) ||
+        !same_item(s.cbegin()[i], m.items[i]))
+      fail("wrong item");
+}
+
+// Pre:  none
+// Post: If m's items weren't in non-decreasing order, s and m have been
+//       sorted.
+template <typename T, size_t N>
+void sort_if_needed(Sequence<T, N> &s, model<T> &m) {
+  for (size_t i = 1; i < m.items.size(); ++i)
+    if (m.items[i] < m.items[i - 1]) {
+      s.sort();
+      sort_model(m.items);
+      m.current = 0;
+      return;
+    }
+}
+
+// Pre:  none
+// Post: One random operation that every Sequence has has been done on s
+//       and on m (or nothing, if its precondition wasn't met).
+template <typename T, size_t N> void step(Sequence<T, N> &s, model<T> &m) {
+  const size_t room = Sequence<T, N>::CAPACITY - m.items.size();
+  size_t n = m.items.size();
+  switch (pick(15)) {
+  case 0:
+    op_name = "start";
+    s.start();
+    m.current = 0;
+    break;
+  case 1:
+    op_name = "end";
+    s.end();
+    m.current = n > 0 ? n - 1 : 0;
+    break;
+  case 2:
+    op_name = "advance";
+    if (m.current < n) {
+      s.advance();
+      ++m.current;
+    }
+    break;
+  case 3:
+    op_name = "move_back";
+    if (m.current < n) {
+      s.move_back();
+      m.current = m.current > 0 ? m.current - 1 : n;
+    }
+    break;
+  case 4:
+  case 5:
+    op_name = "add";
+    if (room > 0) {
+      T x;
+      pick_item(x);
+      s.add(x);
+      m.current = m.current < n ? m.current + 1 : 0;
+      m.items.insert(m.items.begin() + m.current, x);
+    }
+    break;
+  case 6:
+    op_name = "remove_current";
+    if (m.current < n) {
+      s.remove_current();
+      m.items.erase(m.items.begin() + m.current);
+    }
+    break;
+  case 7:
+  case 8: {
+    bool attach = pick(2) == 0;
+    op_name = attach ? "attach_range" : "insert_range";
+    vector<T> items(pick(min(room, MAX_RANGE) + 1));
+    for (size_t i = 0; i < items.size(); ++i)
+      pick_item(items[i]);
+    const T *first = items.empty() ? 0 : &items[0];
+    if (attach)
+      s.attach_range(first, items.size());
+    else
+      s.insert_range(first, items.size());
+    if (!items.empty()) {
+      size_t at = m.current < n ? m.current + attach : 0;
+      m.items.insert(m.items.begin() + at, items.begin(), items.end());
+      m.current = attach ? at + items.size() - 1 : at;
+    }
+    break;
+  }
+  case 9:
+    op_name = "erase_range";
+    if (m.current < n) {
+      size_t count = 1 + pick(MAX_RANGE);
+      s.erase_range(count);
+      m.items.erase(m.items.begin() + m.current,
+                    m.items.begin() + min(n, m.current + count));
+    }
+    break;
+  case 10: {
+    op_name = "seek_lower_bound";
+    sort_if_needed(s, m);
+    T target;
+    pick_item(target);
+    s.seek_lower_bound(target);
+    m.current = lower_bound(m.items.begin(), m.items.end(), target) -
+                m.items.begin();
+    break;
+  }
+  case 11:
+    op_name = "insert_sorted";
+    if (room > 0) {
+      sort_if_needed(s, m);
+      T x;
+      pick_item(x);
+      s.insert_sorted(x);
+      m.current =
+          upper_bound(m.items.begin(), m.items.end(), x) - m.items.begin();
+      m.items.insert(m.items.begin() + m.current, x);
+    }
+    break;
+  case 12:
+    op_name = "sort";
+    s.sort();
+    sort_model(m.items);
+    m.current = 0;
+    break;
+  case 13: {
+    op_name = "remove_if";
+    T target;
+    pick_item(target);
+    bool below = pick(2) == 0;
+    auto pred = [&](const T &x) { return below ? x < target : x == target; };
+    size_t removed = s.remove_if(pred);
+    vector<T> kept;
+    size_t current = 0;
+    for (size_t i = 0; i < n; ++i) {
+      if (i == m.current)
+        current = kept.size();
+      if (!pred(m.items[i]))
+        kept.push_back(m.items[i]);
+    }
+    if (removed != n - kept.size())
+      fail("remove_if returned the wrong count");
+    m.items.swap(kept);
+    m.current = m.current < n ? current : m.items.size();
+    break;
+  }
+  default: {
+    op_name = "copy";
+    Sequence<T, N> copy(s);
+    check(copy, m);
+    if (pick(2) == 0) {
+      Sequence<T, N> empty;
+      s = empty;
+      check(s, model<T>());
+      s = copy;
+    }
+    break;
+  }
+  }
+}
+
+// Pre:  none
+// Post: operations random operations have been done on a Sequence<T, N>
+//       and checked.
+template <typename T, size_t N>
+void test_fixed(const char *name, size_t operations) {
+  sequence_name = name;
+  static Sequence<T, N> s; // (too big for the stack, for a large N)
+  model<T> m;
+  for (op_number = 1; op_number <= operations; ++op_number) {
+    step(s, m);
+    check(s, m);
+  }
+}
+
+// Pre:  none
+// Post: One random operation only seqChar has has been done on s and on
+//       m. other (another sequence, and its model) may take part.
+template <size_t N>
+void step_char(Sequence<char, N> &s, model<char> &m, memory_resource *&r,
+               Sequence<char, N> &other, model<char> &mo,
+               memory_resource *&ro) {
+  size_t n = m.items.size();
+  switch (pick(7)) {
+  case 0: {
+    op_name = "append";
+    char text[8];
+    size_t length = pick(sizeof(text));
+    for (size_t i = 0; i < length; ++i)
+      text[i] = char('a' + pick(3));
+    text[length] = '\0';
+    s.append(text);
+    m.items.insert(m.items.end(), text, text + length);
+    if (m.current == n)
+      m.current = m.items.size(); // (still no current item)
+    break;
+  }
+  case 1: {
+    op_name = "find a char";
+    char target;
+    pick_item(target);
+    bool found = s.find(target);
+    if (m.current < n)
+      m.current = find(m.items.begin() + m.current, m.items.end(), target) -
+                  m.items.begin();
+    if (found != (m.current < n))
+      fail("find returned the wrong value");
+    break;
+  }
+  case 2: {
+    op_name = "find a string";
+    char text[4];
+    size_t length = pick(sizeof(text));
+    for (size_t i = 0; i < length; ++i)
+      text[i] = char('a' + pick(3));
+    text[length] = '\0';
+    bool found = s.find(text);
+    if (m.current < n)
+      m.current = search(m.items.begin() + m.current, m.items.end(), text,
+                         text + length) -
+                  m.items.begin();
+    if (found != (m.current < n))
+      fail("find returned the wrong value");
+    break;
+  }
+  case 3:
+    op_name = "copy assignment";
+    other = s;
+    mo = m; // (other keeps its own resource)
+    break;
+  case 4: {
+    op_name = "copy constructor";
+    Sequence<char, N> copy(s);
+    if (copy.get_resource() != r)
+      fail("a copy doesn't use the original's resource");
+    check(copy, m);
+    break;
+  }
+  case 5: {
+    op_name = "move constructor and move assignment";
+    Sequence<char, N> moved(move(s));
+    if (moved.get_resource() != r || s.size() != 0 || s.is_item())
+      fail("the move constructor didn't take everything over");
+    check(moved, m);
+    s = move(other);
+    other = move(moved);
+    swap(m, mo);
+    swap(r, ro);
+    break;
+  }
+  default:
+    op_name = "new sequence";
+    if (pick(4) == 0) {
+      s = Sequence<char, N>(r); // (s takes the new sequence's resource)
+      m = model<char>();
+    }
+    break;
+  }
+}
+
+// Pre:  none
+// Post: operations random operations have been done on two Sequence<char,
+//       N>s and checked. Their storage comes from the heap, a tracking
+//       resource and a monotonic_arena, and the tracking resource has
+//       been checked to have all its storage given back properly.
+template <size_t N> void test_char(const char *name, size_t operations) {
+  sequence_name = name;
+  block_record record;
+  {
+    tracking_resource tracked(&record);
+    monotonic_arena arena(256);
+    memory_resource *const resources[] = {0, &tracked, &arena};
+    memory_resource *r[2] = {&tracked, 0};
+    Sequence<char, N> s[2] = {Sequence<char, N>(r[0]),
+                              Sequence<char, N>(r[1])};
+    model<char> m[2];
+    for (op_number = 1; op_number <= operations; ++op_number) {
+      size_t i = pick(2);
+      if (m[i].items.size() > MAX_CHARS) {
+        op_name = "cut in half";
+        s[i].start();
+        s[i].erase_range(MAX_CHARS / 2);
+        m[i].items.erase(m[i].items.begin(),
+                         m[i].items.begin() + MAX_CHARS / 2);
+        m[i].current = 0;
+      } else if (pick(3) == 0) {
+        step_char(s[i], m[i], r[i], s[1 - i], m[1 - i], r[1 - i]);
+      } else if (pick(50) == 0) {
+        op_name = "new sequence from a resource";
+        r[i] = resources[pick(3)];
+        s[i] = Sequence<char, N>(r[i]);
+        m[i] = model<char>();
+      } else {
+        step(s[i], m[i]);
+      }
+      for (size_t j = 0; j < 2; ++j) {
+        check(s[j], m[j]);
+        if (s[j].get_resource() != r[j])
+          fail("wrong resource");
+      }
+      if (record.errors != 0)
+        fail("storage was given back to the wrong resource or twice");
+    }
+  }
+  op_name = "end";
+  if (record.errors != 0 || !record.live.empty())
+    fail("storage was not given back, or not properly");
+}
+
+int main(int argc, char *argv[]) {
+  size_t operations = 100000;
+  size_t seed = 1;
+  if (argc > 1)
+    operations = size_t(atol(argv[1]));
+  if (argc > 2)
+    seed = size_t(atol(argv[2]));
+  rng.seed(seed);
+
+  test_fixed<double, 1>("Sequence<double, 1>", operations);
+  test_fixed<double, 10>("Sequence<double, 10>", operations);
+  test_fixed<double, 64>("Sequence<double, 64>", operations);
+  test_fixed<double, 300>("Sequence<double, 300>", operations);
+  test_fixed<int, 64>("Sequence<int, 64>", operations);
+  test_fixed<string, 1>("Sequence<string, 1>", operations);
+  test_fixed<string, 64>("Sequence<string, 64>", operations);
+  test_char<10>("seqChar", operations);
+  test_char<0>("Sequence<char, 0>", operations);
+
+  cout << operations << " operations on each of 9 kinds of sequence "
+       << "checked: passed" << endl;
+  return EXIT_SUCCESS;
+}
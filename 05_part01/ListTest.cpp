@@ -0,0 +1,195 @@
+// FILE: ListTest.cpp
+//       A non-interactive test program for the List overloads of the
+//       linked-list toolkit (llcpInt.h).
+//
+// DESCRIPTION:
+// Random lists, some kept sorted, are edited with the List overloads and,
+// side by side, with the Node* functions on a second list; after each
+// change both must hold exactly what a vector holds, and the List's tail
+// and length must match its nodes. ShowAll, FindMinMax, FindAverage,
+// IsSortedUp and MakeOddsAndEvensMeshedAtFront must give the same
+// results for both, and MakeList must rebuild the List from its head.
+// Last, a long List is built with InsertAsTail, which must be O(1).
+//
+// USAGE:
+//   a5list
+// Prints the number of lists checked and "passed", or the first check
+// that failed and "FAILED"; the exit status is EXIT_SUCCESS only if it
+// passed.
+
+#include "NodePool.h"
+#include "llcpInt.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>  // provides exit, EXIT_SUCCESS, EXIT_FAILURE
+#include <iostream> // provides cout
+#include <random>
+#include <sstream>
+#include <vector>
+using namespace std;
+
+const int LISTS = 20000;
+const int CHANGES_PER_LIST = 40;
+const int LONG_LIST = 1 << 20;
+
+// DelFirstTargetNode prints to cout when the target isn't found, so cout
+// is sent elsewhere and the results go here.
+ostream report(cout.rdbuf());
+int listNumber = 0;
+
+void fail(const char *what) {
+  report << "list " << listNumber << ": " << what << endl
+         << "FAILED" << endl;
+  exit(EXIT_FAILURE);
+}
+
+// Pre:  none
+// Post: list and headPtr have been checked to hold exactly the values in
+//       model (and list its right tail and length), and the program has
+//       stopped if they don't.
+void Check(const List &list, Node *headPtr, const vector<int> &model) {
+  Node *last = 0;
+  size_t i = 0;
+  for (Node *p = list.head; p != 0; p = p->link, ++i) {
+    if (i >= model.size() || p->data != model[i])
+      fail("the List doesn't hold the right values");
+    last = p;
+  }
+  if (i != model.size())
+    fail("the List is missing nodes");
+  if (list.tail != last)
+    fail("the List's tail is not its last node");
+  if (FindListLength(list) != int(model.size()))
+    fail("the List's length is wrong");
+  if (FindListLength(headPtr) != int(model.size()))
+    fail("the Node* list's length is wrong");
+  i = 0;
+  for (Node *p = headPtr; p != 0; p = p->link, ++i)
+    if (p->data != model[i])
+      fail("the Node* list doesn't hold the right values");
+}
+
+// Pre:  none
+// Post: the functions that only look at a list have been checked to give
+//       the same results for list and headPtr (which hold model).
+void CheckQueries(const List &list, Node *headPtr, const vector<int> &model) {
+  ostringstream listOut, nodeOut;
+  ShowAll(listOut, list);
+  ShowAll(nodeOut, headPtr);
+  if (listOut.str() != nodeOut.str())
+    fail("ShowAll differs");
+  if (IsSortedUp(list) != is_sorted(model.begin(), model.end()) ||
+      IsSortedUp(headPtr) != IsSortedUp(list))
+    fail("IsSortedUp is wrong");
+  if (model.empty())
+    return;
+  int listMin, listMax, nodeMin, nodeMax;
+  FindMinMax(list, listMin, listMax);
+  FindMinMax(headPtr, nodeMin, nodeMax);
+  if (listMin != *min_element(model.begin(), model.end()) ||
+      listMax != *max_element(model.begin(), model.end()) ||
+      nodeMin != listMin || nodeMax != listMax)
+    fail("FindMinMax is wrong");
+  if (FindAverage(list) != FindAverage(headPtr))
+    fail("FindAverage differs");
+}
+
+int main() {
+  ostringstream sink;
+  cout.rdbuf(sink.rdbuf());
+  mt19937 gen(1);
+
+  for (listNumber = 0; listNumber < LISTS; ++listNumber) {
+    List list = {0, 0, 0};
+    Node *headPtr = 0;
+    vector<int> model;
+    bool sorted = gen() % 2 == 0;
+
+    for (int change = 0; change < CHANGES_PER_LIST; ++change) {
+      int value = gen() % 10;
+      vector<int>::iterator found = find(model.begin(), model.end(), value);
+
+      switch (gen() % 6) {
+      case 0:
+      case 1:
+        if (sorted) {
+          InsertSortedUp(list, value);
+          InsertSortedUp(headPtr, value);
+          model.insert(lower_bound(model.begin(), model.end(), value), value);
+        } else if (gen() % 2 == 0) {
+          InsertAsHead(list, value);
+          InsertAsHead(headPtr, value);
+          model.insert(model.begin(), value);
+        } else {
+          InsertAsTail(list, value);
+          InsertAsTail(headPtr, value);
+          model.push_back(value);
+        }
+        break;
+      case 2:
+        if (DelFirstTargetNode(list, value) != (found != model.end()) ||
+            DelFirstTargetNode(headPtr, value) != (found != model.end()))
+          fail("DelFirstTargetNode returned the wrong result");
+        if (found != model.end())
+          model.erase(found);
+        break;
+      case 3:
+        if (DelNodeBefore1stMatch(list, value) !=
+                (found != model.end() && found != model.begin()) ||
+            DelNodeBefore1stMatch(headPtr, value) !=
+                (found != model.end() && found != model.begin()))
+          fail("DelNodeBefore1stMatch returned the wrong result");
+        if (found != model.end() && found != model.begin())
+          model.erase(found - 1);
+        break;
+      case 4:
+        if (!sorted && gen() % 4 == 0) {
+          MakeOddsAndEvensMeshedAtFront(list);
+          MakeOddsAndEvensMeshedAtFront(headPtr);
+          vector<int> meshed;
+          for (Node *p = list.head; p != 0; p = p->link)
+            meshed.push_back(p->data);
+          vector<int> before = model, after = meshed;
+          sort(before.begin(), before.end());
+          sort(after.begin(), after.end());
+          if (before != after)
+            fail("MakeOddsAndEvensMeshedAtFront lost or added values");
+          model = meshed;
+        }
+        break;
+      default:
+        CheckQueries(list, headPtr, model);
+        break;
+      }
+      Check(list, headPtr, model);
+    }
+
+    List rebuilt = MakeList(list.head);
+    if (rebuilt.head != list.head || rebuilt.tail != list.tail ||
+        rebuilt.length != list.length)
+      fail("MakeList doesn't rebuild the List");
+    ListClear(list, 1);
+    ListClear(headPtr, 1);
+    Check(list, headPtr, vector<int>());
+  }
+  report << LISTS << " lists of up to " << CHANGES_PER_LIST
+         << " changes: ok" << endl;
+
+  // Appending is O(1), so this takes milliseconds; an O(n) InsertAsTail
+  // would take minutes.
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  List list = {0, 0, 0};
+  for (int i = 0; i < LONG_LIST; ++i)
+    InsertAsTail(list, i);
+  double ms = chrono::duration<double, milli>(chrono::steady_clock::now() -
+                                              start).count();
+  if (FindListLength(list) != LONG_LIST || list.tail->data != LONG_LIST - 1 ||
+      !IsSortedUp(list))
+    fail("the long List is wrong");
+  ListClear(list, 1);
+  report << LONG_LIST << " nodes appended in " << ms << " ms: ok" << endl;
+
+  cout.rdbuf(report.rdbuf());
+  report << "passed" << endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,136 @@
+#include "NodePool.h"
+#include <mutex>
+#include <vector>
+using namespace std;
+
+namespace {
+// The most single freed nodes, and whole freed lists, that a thread
+// keeps for itself; the rest go to the SlabStore (see FreeStore::Spill),
+// so that a thread freeing more nodes than it allocates (such as one
+// freeing nodes allocated by others) doesn't hoard them.
+const int MAX_FREE_NODES = NODES_PER_SLAB;
+const size_t MAX_FREE_LISTS = 16;
+
+// Every slab ever allocated, deleted at exit; and the free nodes of
+// threads that have exited or kept too many, as whole lists, for other
+// threads to reuse.
+struct SlabStore {
+  mutex lock;
+  vector<Node *> slabs;
+  vector<Node *> spareLists;
+  ~SlabStore() {
+    for (size_t i = 0; i < slabs.size(); ++i)
+      delete[] slabs[i];
+  }
+};
+
+SlabStore &Slabs() {
+  static SlabStore store;
+  return store;
+}
+
+// A thread's free nodes: single freed nodes on freeHead (freeCount of
+// them), whole freed lists on freeLists (each taken from its front as it
+// is reused), and the part of its current slab not handed out yet, from
+// slabNext to slabEnd.
+struct FreeStore {
+  Node *freeHead;
+  int freeCount;
+  vector<Node *> freeLists;
+  Node *slabNext, *slabEnd;
+
+  FreeStore() : freeHead(0), freeCount(0), slabNext(0), slabEnd(0) {}
+
+  ~FreeStore() {
+    // Link the unused rest of the slab up as one more list.
+    for (Node *p = slabNext; p != slabEnd; ++p)
+      p->link = (p + 1 != slabEnd) ? p + 1 : 0;
+    if (slabNext != slabEnd)
+      freeLists.push_back(slabNext);
+    if (freeHead != 0)
+      freeLists.push_back(freeHead);
+    SlabStore &store = Slabs();
+    lock_guard<mutex> guard(store.lock);
+    store.spareLists.insert(store.spareLists.end(), freeLists.begin(),
+                            freeLists.end());
+  }
+
+  // Hands the single freed nodes (unless keepNodes) and all the freed
+  // lists but the newest one over to the SlabStore.
+  void Spill(bool keepNodes) {
+    SlabStore &store = Slabs();
+    lock_guard<mutex> guard(store.lock);
+    if (!keepNodes) {
+      store.spareLists.push_back(freeHead);
+      freeHead = 0;
+      freeCount = 0;
+    }
+    if (freeLists.size() > 1) {
+      store.spareLists.insert(store.spareLists.end(), freeLists.begin(),
+                              freeLists.end() - 1);
+      freeLists.erase(freeLists.begin(), freeLists.end() - 1);
+    }
+  }
+
+  // Gets more free nodes: a list left by an exited thread if there is
+  // one, otherwise a new slab.
+  void Refill() {
+    SlabStore &store = Slabs();
+    lock_guard<mutex> guard(store.lock);
+    if (!store.spareLists.empty()) {
+      freeLists.push_back(store.spareLists.back());
+      store.spareLists.pop_back();
+    } else {
+      // Make room first (doubling), so the push_back below can't throw
+      // and leak the new slab.
+      if (store.slabs.size() == store.slabs.capacity())
+        store.slabs.reserve(2 * store.slabs.size() + 1);
+      slabNext = new Node[NODES_PER_SLAB];
+      slabEnd = slabNext + NODES_PER_SLAB;
+      store.slabs.push_back(slabNext);
+    }
+  }
+};
+
+thread_local FreeStore freeStore;
+} // namespace
+
+Node *NodeAlloc() {
+  FreeStore &fs = freeStore;
+  for (;;) {
+    if (fs.freeHead != 0) {
+      Node *nodePtr = fs.freeHead;
+      fs.freeHead = nodePtr->link;
+      --fs.freeCount;
+      return nodePtr;
+    }
+    if (!fs.freeLists.empty()) {
+      Node *nodePtr = fs.freeLists.back();
+      if (nodePtr->link != 0)
+        fs.freeLists.back() = nodePtr->link;
+      else
+        fs.freeLists.pop_back();
+      return nodePtr;
+    }
+    if (fs.slabNext != fs.slabEnd)
+      return fs.slabNext++;
+    fs.Refill();
+  }
+}
+
+void NodeFree(Node *nodePtr) {
+  FreeStore &fs = freeStore;
+  nodePtr->link = fs.freeHead;
+  fs.freeHead = nodePtr;
+  if (++fs.freeCount > MAX_FREE_NODES)
+    fs.Spill(false);
+}
+
+void NodeFreeList(Node *headPtr) {
+  FreeStore &fs = freeStore;
+  if (headPtr != 0) {
+    fs.freeLists.push_back(headPtr);
+    if (fs.freeLists.size() > MAX_FREE_LISTS)
+      fs.Spill(true);
+  }
+}
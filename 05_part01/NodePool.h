@@ -0,0 +1,31 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include "llcpInt.h"
+
+// A pool that the toolkit functions get their Nodes from, instead of new
+// and delete. Nodes are carved out of slabs of NODES_PER_SLAB Nodes, and
+// each thread keeps its own free list, so allocating or freeing a node
+// takes no lock: only getting a new slab (once per NODES_PER_SLAB nodes)
+// does. A node may be freed by a different thread than the one that
+// allocated it: a thread keeps only a bounded number of freed nodes (and
+// freed lists) for itself, and hands the rest, as whole lists, on to
+// threads that need more (taking a lock once per batch). Slabs are only
+// given back to the system when the program exits; the nodes a thread
+// has freed but not reused when it exits are handed on to other threads.
+const int NODES_PER_SLAB = 4096;
+
+// Returns a node from the calling thread's free list, or from a slab
+// (data and link are not set).
+Node *NodeAlloc();
+
+// Returns the node at nodePtr (which must have come from NodeAlloc) to
+// the calling thread's free list.
+void NodeFree(Node *nodePtr);
+
+// Returns all the nodes of the list at headPtr (which must all have come
+// from NodeAlloc) to the calling thread's free list at once, in O(1):
+// the list is kept whole and its nodes are reused from its front.
+void NodeFreeList(Node *headPtr);
+
+#endif
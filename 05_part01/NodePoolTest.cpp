@@ -0,0 +1,250 @@
+// FILE: NodePoolTest.cpp
+//       A non-interactive test program for the node pool (NodePool.h)
+//       used by several threads at once.
+//
+// DESCRIPTION:
+// 1. Several threads each build and edit lists with the toolkit functions
+//    (so all their nodes come from the pool), checking every list against
+//    a vector after each change; now and then a thread hands one of its
+//    lists to another thread, which frees it. A node handed out to two
+//    lists at once shows up as a list that doesn't match its vector.
+// 2. One thread allocates many nodes and another frees them (half with
+//    NodeFree, half with NodeFreeList), over and over: the nodes must be
+//    reused, not hoarded by the freeing thread, so the number of different
+//    nodes ever handed out must stay close to the number alive at once.
+// 3. A thread frees all its nodes and exits: the next thread to allocate
+//    must get those nodes back.
+//
+// USAGE:
+//   a5pool
+// Prints what each part checked and "passed", or the first check that
+// failed and "FAILED"; the exit status is EXIT_SUCCESS only if it
+// passed. Building it with -fsanitize=thread also catches data races in
+// the pool.
+
+#include "NodePool.h"
+#include "llcpInt.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>  // provides exit, EXIT_SUCCESS, EXIT_FAILURE
+#include <iostream> // provides cout
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+using namespace std;
+
+const int THREADS = 4;
+const int LISTS_PER_THREAD = 8;
+const int OPS_PER_THREAD = 40000;
+const int CROSS_FREE_NODES = 1 << 18;
+const int CROSS_FREE_ROUNDS = 20;
+
+mutex failLock;
+
+void fail(const char *part, const char *what) {
+  lock_guard<mutex> guard(failLock);
+  cout << part << ": " << what << endl << "FAILED" << endl;
+  exit(EXIT_FAILURE);
+}
+
+// Pre:  none
+// Post: the list at headPtr has been checked to hold exactly the values
+//       in model, and the program has stopped if it doesn't.
+void CheckList(Node *headPtr, const vector<int> &model) {
+  size_t i = 0;
+  for (Node *p = headPtr; p != 0; p = p->link)
+    if (i >= model.size() || p->data != model[i++])
+      fail("threads", "a list doesn't hold what was put in it");
+  if (i != model.size())
+    fail("threads", "a list is missing nodes");
+}
+
+// Lists given up by one thread, for another to free.
+mutex handoffLock;
+vector<Node *> handoff;
+
+// Pre:  none
+// Post: OPS_PER_THREAD random changes have been made to LISTS_PER_THREAD
+//       lists (half of them kept sorted), each list checked after each
+//       change, and all the lists freed.
+void Work(unsigned seed) {
+  mt19937 gen(seed);
+  Node *lists[LISTS_PER_THREAD] = {0};
+  vector<int> models[LISTS_PER_THREAD];
+
+  for (int op = 0; op < OPS_PER_THREAD; ++op) {
+    int k = gen() % LISTS_PER_THREAD;
+    bool sorted = k % 2 == 0;
+    Node *&list = lists[k];
+    vector<int> &model = models[k];
+    int value = gen() % 100;
+
+    switch (gen() % 8) {
+    case 0:
+    case 1:
+      if (sorted) {
+        InsertSortedUp(list, value);
+        model.insert(lower_bound(model.begin(), model.end(), value), value);
+      } else {
+        InsertAsHead(list, value);
+        model.insert(model.begin(), value);
+      }
+      break;
+    case 2:
+    case 3:
+      if (sorted) {
+        InsertSortedUp(list, value);
+        model.insert(lower_bound(model.begin(), model.end(), value), value);
+      } else {
+        InsertAsTail(list, value);
+        model.push_back(value);
+      }
+      break;
+    case 4:
+    case 5:
+      if (!model.empty())
+        value = model[gen() % model.size()];
+      if (DelFirstTargetNode(list, value) !=
+          (find(model.begin(), model.end(), value) != model.end()))
+        fail("threads", "DelFirstTargetNode returned the wrong result");
+      if (find(model.begin(), model.end(), value) != model.end())
+        model.erase(find(model.begin(), model.end(), value));
+      break;
+    case 6:
+      if (gen() % 4 == 0) {
+        ListClear(list, 1);
+        model.clear();
+      }
+      break;
+    default:
+      if (gen() % 4 == 0) {
+        // Hand this list to whichever thread comes next, and free the
+        // one handed over before (likely by another thread).
+        Node *other = 0;
+        {
+          lock_guard<mutex> guard(handoffLock);
+          if (!handoff.empty()) {
+            other = handoff.back();
+            handoff.pop_back();
+          }
+          handoff.push_back(list);
+        }
+        list = 0;
+        model.clear();
+        ListClear(other, 1);
+      }
+      break;
+    }
+    CheckList(list, model);
+  }
+  for (int k = 0; k < LISTS_PER_THREAD; ++k)
+    ListClear(lists[k], 1);
+}
+
+// Pre:  none
+// Post: part 1 has been run (see the DESCRIPTION above).
+void TestThreads() {
+  vector<thread> threads;
+  for (int t = 0; t < THREADS; ++t)
+    threads.push_back(thread(Work, t + 1));
+  Work(0);
+  for (int t = 0; t < THREADS; ++t)
+    threads[t].join();
+  for (size_t i = 0; i < handoff.size(); ++i)
+    ListClear(handoff[i], 1);
+  handoff.clear();
+  cout << THREADS + 1 << " threads, " << OPS_PER_THREAD
+       << " list changes each: ok" << endl;
+}
+
+// Pre:  none
+// Post: part 2 has been run (see the DESCRIPTION above).
+void TestCrossThreadFree() {
+  vector<Node *> nodes(CROSS_FREE_NODES);
+  unordered_set<Node *> seen;
+  seen.reserve(4 * CROSS_FREE_NODES);
+  atomic<int> phase(0);
+
+  // Frees each round's nodes once the main thread has allocated them.
+  thread freer([&] {
+    for (int round = 0; round < CROSS_FREE_ROUNDS; ++round) {
+      while (phase.load() != 2 * round + 1)
+        this_thread::yield();
+      for (int i = 0; i < CROSS_FREE_NODES; ++i)
+        if (i % 2 != 0) {
+          NodeFree(nodes[i]);
+        } else {
+          nodes[i]->link = 0;
+          NodeFreeList(nodes[i]);
+        }
+      phase.store(2 * round + 2);
+    }
+  });
+
+  for (int round = 0; round < CROSS_FREE_ROUNDS; ++round) {
+    for (int i = 0; i < CROSS_FREE_NODES; ++i) {
+      nodes[i] = NodeAlloc();
+      nodes[i]->data = i;
+      seen.insert(nodes[i]);
+    }
+    for (int i = 0; i < CROSS_FREE_NODES; ++i)
+      if (nodes[i]->data != i)
+        fail("cross-thread free", "a node was handed out twice");
+    phase.store(2 * round + 1);
+    while (phase.load() != 2 * round + 2)
+      this_thread::yield();
+  }
+  freer.join();
+
+  // Each round's nodes should come back from the freeing thread's
+  // spills, but for the few the two threads keep for themselves.
+  if (seen.size() > 2 * size_t(CROSS_FREE_NODES))
+    fail("cross-thread free", "freed nodes are not being reused");
+  cout << CROSS_FREE_ROUNDS << " rounds of " << CROSS_FREE_NODES
+       << " nodes freed by another thread: " << seen.size()
+       << " different nodes used, ok" << endl;
+}
+
+// Pre:  no other threads are using the pool
+// Post: part 3 has been run (see the DESCRIPTION above).
+void TestThreadExit() {
+  const int count = 16 * NODES_PER_SLAB;
+  unordered_set<Node *> freed;
+
+  thread leaving([&] {
+    Node *headPtr = 0;
+    for (int i = 0; i < count; ++i) {
+      InsertAsHead(headPtr, i);
+      freed.insert(headPtr);
+    }
+    ListClear(headPtr, 1);
+  });
+  leaving.join();
+
+  int reused = 0;
+  thread arriving([&] {
+    vector<Node *> nodes(count);
+    for (int i = 0; i < count; ++i) {
+      nodes[i] = NodeAlloc();
+      reused += freed.count(nodes[i]);
+    }
+    for (int i = 0; i < count; ++i)
+      NodeFree(nodes[i]);
+  });
+  arriving.join();
+
+  if (reused < count - NODES_PER_SLAB)
+    fail("thread exit", "an exited thread's free nodes were not reused");
+  cout << reused << " of " << count
+       << " nodes freed by an exited thread reused: ok" << endl;
+}
+
+int main() {
+  TestThreads();
+  TestCrossThreadFree();
+  TestThreadExit();
+  cout << "passed" << endl;
+  return EXIT_SUCCESS;
+}
@@ -1,4 +1,5 @@
 #include "llcpInt.h"
+#include "NodePool.h"
 #include <cstdlib>
 #include <iostream>
 using namespace std;
@@ -91,14 +92,14 @@ bool IsSortedUp(Node *headPtr) {
 }
 
 void InsertAsHead(Node *&headPtr, int value) {
-  Node *newNodePtr = new Node;
+  Node *newNodePtr = NodeAlloc();
   newNodePtr->data = value;
   newNodePtr->link = headPtr;
   headPtr = newNodePtr;
 }
 
 void InsertAsTail(Node *&headPtr, int value) {
-  Node *newNodePtr = new Node;
+  Node *newNodePtr = NodeAlloc();
   newNodePtr->data = value;
   newNodePtr->link = 0;
   if (headPtr == 0)
@@ -120,7 +121,7 @@ void InsertSortedUp(Node *&headPtr, int value) {
     cursor = cursor->link;
   }
 
-  Node *newNodePtr = new Node;
+  Node *newNodePtr = NodeAlloc();
   newNodePtr->data = value;
   newNodePtr->link = cursor;
   if (cursor == headPtr)
@@ -194,7 +195,7 @@ bool DelFirstTargetNode(Node *&headPtr, int target) {
     headPtr = headPtr->link;
   else
     precursor->link = cursor->link;
-  delete cursor;
+  NodeFree(cursor);
   return true;
 }
 
@@ -211,10 +212,10 @@ bool DelNodeBefore1stMatch(Node *&headPtr, int target) {
     return false;
   if (cur == headPtr->link) {
     headPtr = cur;
-    delete pre;
+    NodeFree(pre);
   } else {
     prepre->link = cur;
-    delete pre;
+    NodeFree(pre);
   }
   return true;
 }
@@ -261,17 +262,114 @@ double FindAverage(Node *headPtr) {
   }
 }
 
+// The nodes go back to the pool as one list, so without the message
+// (which needs a count) this is O(1).
 void ListClear(Node *&headPtr, int noMsg) {
-  int count = 0;
+  int count = noMsg ? 0 : FindListLength(headPtr);
 
-  Node *cursor = headPtr;
-  while (headPtr != 0) {
-    headPtr = headPtr->link;
-    delete cursor;
-    cursor = headPtr;
-    ++count;
-  }
+  NodeFreeList(headPtr);
+  headPtr = 0;
   if (noMsg)
     return;
   clog << "Dynamic memory for " << count << " nodes freed" << endl;
 }
+
+List MakeList(Node *headPtr) {
+  List list = {headPtr, 0, 0};
+
+  for (Node *cursor = headPtr; cursor != 0; cursor = cursor->link) {
+    list.tail = cursor;
+    ++list.length;
+  }
+  return list;
+}
+
+int FindListLength(const List &list) { return list.length; }
+
+bool IsSortedUp(const List &list) { return IsSortedUp(list.head); }
+
+void InsertAsHead(List &list, int value) {
+  InsertAsHead(list.head, value);
+  if (list.tail == 0)
+    list.tail = list.head;
+  ++list.length;
+}
+
+void InsertAsTail(List &list, int value) {
+  Node *newNodePtr = NodeAlloc();
+  newNodePtr->data = value;
+  newNodePtr->link = 0;
+  if (list.tail == 0)
+    list.head = newNodePtr;
+  else
+    list.tail->link = newNodePtr;
+  list.tail = newNodePtr;
+  ++list.length;
+}
+
+void InsertSortedUp(List &list, int value) {
+  // A value above the last one is appended without a search; any other
+  // goes in before the tail at the latest, so the tail stays the same.
+  if (list.tail == 0 || list.tail->data < value)
+    InsertAsTail(list, value);
+  else {
+    InsertSortedUp(list.head, value);
+    ++list.length;
+  }
+}
+
+bool DelFirstTargetNode(List &list, int target) {
+  Node *precursor = 0, *cursor = list.head;
+
+  while (cursor != 0 && cursor->data != target) {
+    precursor = cursor;
+    cursor = cursor->link;
+  }
+  if (cursor == 0) {
+    cout << target << " not found." << endl;
+    return false;
+  }
+  if (cursor == list.head) // OR precursor == 0
+    list.head = list.head->link;
+  else
+    precursor->link = cursor->link;
+  if (cursor == list.tail)
+    list.tail = precursor;
+  NodeFree(cursor);
+  --list.length;
+  return true;
+}
+
+bool DelNodeBefore1stMatch(List &list, int target) {
+  // The node deleted is followed by the match, so it's never the tail.
+  if (!DelNodeBefore1stMatch(list.head, target))
+    return false;
+  --list.length;
+  return true;
+}
+
+void ShowAll(ostream &outs, const List &list) { ShowAll(outs, list.head); }
+
+void FindMinMax(const List &list, int &minValue, int &maxValue) {
+  FindMinMax(list.head, minValue, maxValue);
+}
+
+double FindAverage(const List &list) { return FindAverage(list.head); }
+
+void ListClear(List &list, int noMsg) {
+  int count = list.length;
+
+  ListClear(list.head, 1);
+  list.tail = 0;
+  list.length = 0;
+  if (noMsg)
+    return;
+  clog << "Dynamic memory for " << count << " nodes freed" << endl;
+}
+
+void MakeOddsAndEvensMeshedAtFront(List &list) {
+  // The nodes are relinked in a new order, so the tail must be found
+  // again (the function is O(n) anyway).
+  MakeOddsAndEvensMeshedAtFront(list.head);
+  list = MakeList(list.head);
+}
@@ -10,6 +10,11 @@ struct Node {
 
 int FindListLength(Node *headPtr);
 bool IsSortedUp(Node *headPtr);
+// The nodes these functions add (InsertAsHead, InsertAsTail and
+// InsertSortedUp, for Node* and List alike) come from the node pool (see
+// NodePool.h), not from new: they are parts of slabs and must never be
+// deleted. Give them back with NodeFree (NodeFreeList for a whole list),
+// or through DelFirstTargetNode, DelNodeBefore1stMatch or ListClear.
 void InsertAsHead(Node *&headPtr, int value);
 void InsertAsTail(Node *&headPtr, int value);
 void InsertSortedUp(Node *&headPtr, int value);
@@ -18,8 +23,41 @@ bool DelNodeBefore1stMatch(Node *&headPtr, int target);
 void ShowAll(std::ostream &outs, Node *headPtr);
 void FindMinMax(Node *headPtr, int &minValue, int &maxValue);
 double FindAverage(Node *headPtr);
+// DelFirstTargetNode, DelNodeBefore1stMatch and ListClear give the nodes
+// they remove back to the pool (ListClear hands over the whole list at
+// once, in O(1) if noMsg is set), where later insertions reuse them;
+// they are not returned to the system. Slabs are only freed when the
+// program exits (finding the slabs whose nodes are all free would take
+// a walk over every freed node), so the memory a program's lists take
+// stays at its peak. A node made with new may still be in a list these
+// functions remove from; it then joins the pool and is never deleted.
 void ListClear(Node *&headPtr, int noMsg = 0);
 
-void MakeOddsAndEvensMeshedAtFront(Node *&headPtr);
+void MakeOddsAndEvensMeshedAtFront(Node *&headPtr);
+
+// A handle on a list that also keeps its last node and its length, so
+// that appending (InsertAsTail) and FindListLength are O(1). The
+// functions below do what their Node* versions do, keeping tail and
+// length up to date. Start with an empty List (List list = {0, 0, 0}),
+// or wrap an existing list with MakeList.
+struct List {
+  Node *head;
+  Node *tail;
+  int length;
+};
+
+List MakeList(Node *headPtr);
+int FindListLength(const List &list);
+bool IsSortedUp(const List &list);
+void InsertAsHead(List &list, int value);
+void InsertAsTail(List &list, int value);
+void InsertSortedUp(List &list, int value);
+bool DelFirstTargetNode(List &list, int target);
+bool DelNodeBefore1stMatch(List &list, int target);
+void ShowAll(std::ostream &outs, const List &list);
+void FindMinMax(const List &list, int &minValue, int &maxValue);
+double FindAverage(const List &list);
+void ListClear(List &list, int noMsg = 0);
+void MakeOddsAndEvensMeshedAtFront(List &list);
 
 #endif
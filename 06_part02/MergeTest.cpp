@@ -0,0 +1,149 @@
+// FILE: MergeTest.cpp
+//       A non-interactive test program for Merge2NonDecListsIter and
+//       MergeKNonDecLists.
+//
+// DESCRIPTION:
+// Random non-decreasing lists (often empty, with many equal values) are
+// merged, and the merged list must hold exactly the nodes of the lists,
+// in the order a stable sort of them by value gives, which is also the
+// order Merge2NonDecListsRecur gives; the lists merged must be left
+// empty. Last, two lists of a million nodes each (far too long for the
+// recursive version) and 500 lists of 4000 nodes each are merged.
+//
+// USAGE:
+//   a6merge
+// Prints the number of merges checked and "passed", or the first check
+// that failed and "FAILED"; the exit status is EXIT_SUCCESS only if it
+// passed.
+
+#include "llcpInt.h"
+#include <algorithm>
+#include <cstdlib>  // provides exit, EXIT_SUCCESS, EXIT_FAILURE
+#include <iostream> // provides cout
+#include <random>
+#include <vector>
+using namespace std;
+
+const int MERGES = 20000;
+const int MAX_LISTS = 12;
+const int MAX_LENGTH = 30;
+
+mt19937 gen(1);
+int mergeNumber = 0;
+
+void fail(const char *what) {
+  cout << "merge " << mergeNumber << ": " << what << endl
+       << "FAILED" << endl;
+  exit(EXIT_FAILURE);
+}
+
+bool LessData(const Node *a, const Node *b) { return a->data < b->data; }
+
+// Pre:  none
+// Post: the return value is the nodes of the list at headPtr, in order.
+vector<Node *> NodesOf(Node *headPtr) {
+  vector<Node *> nodes;
+  for (; headPtr != NULL; headPtr = headPtr->link)
+    nodes.push_back(headPtr);
+  return nodes;
+}
+
+// Pre:  length >= 0
+// Post: the return value is a new non-decreasing list of length random
+//       values below range, and its nodes have been added to nodes.
+Node *MakeNonDec(int length, int range, vector<Node *> &nodes) {
+  vector<int> values(length);
+  for (int i = 0; i < length; ++i)
+    values[i] = gen() % range;
+  sort(values.begin(), values.end());
+  Node *headPtr = NULL, **tailLink = &headPtr;
+  for (int i = 0; i < length; ++i) {
+    Node *newNodePtr = new Node;
+    newNodePtr->data = values[i];
+    newNodePtr->link = NULL;
+    *tailLink = newNodePtr;
+    tailLink = &newNodePtr->link;
+    nodes.push_back(newNodePtr);
+  }
+  return headPtr;
+}
+
+// Pre:  none
+// Post: the return value is a random list length, 0 a third of the time.
+int RandomLength(int maxLength) {
+  return gen() % 3 == 0 ? 0 : gen() % (maxLength + 1);
+}
+
+int main() {
+  for (mergeNumber = 0; mergeNumber < MERGES; ++mergeNumber) {
+    int range = 1 + gen() % 20;
+
+    // Two lists, merged both ways.
+    vector<Node *> nodesX, nodesY;
+    Node *headX = MakeNonDec(RandomLength(MAX_LENGTH), range, nodesX);
+    Node *headY = MakeNonDec(RandomLength(MAX_LENGTH), range, nodesY);
+    vector<Node *> expected = nodesX;
+    expected.insert(expected.end(), nodesY.begin(), nodesY.end());
+    stable_sort(expected.begin(), expected.end(), LessData);
+
+    Node *headZ = NULL;
+    Merge2NonDecListsIter(headX, headY, headZ);
+    if (headX != NULL || headY != NULL)
+      fail("Merge2NonDecListsIter didn't empty its lists");
+    if (NodesOf(headZ) != expected)
+      fail("Merge2NonDecListsIter merged wrongly");
+    // Split the merged list back up and merge it again recursively.
+    headX = headY = NULL;
+    for (size_t i = nodesX.size(); i-- > 0;) {
+      nodesX[i]->link = headX;
+      headX = nodesX[i];
+    }
+    for (size_t i = nodesY.size(); i-- > 0;) {
+      nodesY[i]->link = headY;
+      headY = nodesY[i];
+    }
+    headZ = NULL;
+    Merge2NonDecListsRecur(headX, headY, headZ);
+    if (NodesOf(headZ) != expected)
+      fail("Merge2NonDecListsRecur and Merge2NonDecListsIter differ");
+    ListClear(headZ, 1);
+
+    // k lists.
+    int k = gen() % (MAX_LISTS + 1);
+    vector<Node *> heads(k + 1), all;
+    for (int i = 0; i < k; ++i)
+      heads[i] = MakeNonDec(RandomLength(MAX_LENGTH), range, all);
+    stable_sort(all.begin(), all.end(), LessData);
+    headZ = NULL;
+    MergeKNonDecLists(&heads[0], k, headZ);
+    for (int i = 0; i < k; ++i)
+      if (heads[i] != NULL)
+        fail("MergeKNonDecLists didn't empty its lists");
+    if (NodesOf(headZ) != all)
+      fail("MergeKNonDecLists merged wrongly");
+    ListClear(headZ, 1);
+  }
+  cout << MERGES << " two-list and k-list merges: ok" << endl;
+
+  vector<Node *> nodes;
+  Node *headX = MakeNonDec(1000000, 1 << 30, nodes);
+  Node *headY = MakeNonDec(1000000, 1 << 30, nodes);
+  Node *headZ = NULL;
+  Merge2NonDecListsIter(headX, headY, headZ);
+  if (FindListLength(headZ) != 2000000 || !IsSortedUp(headZ))
+    fail("merging two long lists went wrong");
+  ListClear(headZ, 1);
+
+  vector<Node *> heads(500);
+  for (size_t i = 0; i < heads.size(); ++i)
+    heads[i] = MakeNonDec(4000, 1 << 30, nodes);
+  headZ = NULL;
+  MergeKNonDecLists(&heads[0], int(heads.size()), headZ);
+  if (FindListLength(headZ) != 2000000 || !IsSortedUp(headZ))
+    fail("merging 500 lists went wrong");
+  ListClear(headZ, 1);
+  cout << "2 lists of 1000000 and 500 lists of 4000: ok" << endl;
+
+  cout << "passed" << endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,165 @@
+// FILE: SortTest.cpp
+//       A non-interactive test program for SortNonDec and MakeSorted.
+//
+// DESCRIPTION:
+// Lists of random, nearly sorted, sorted, reversed and all-equal values
+// are sorted with SortNonDec, which must relink exactly their nodes into
+// the order a stable sort of them by value gives. MakeSorted then adds
+// random values to sorted and to unsorted lists: the result must be
+// non-decreasing, hold the old nodes in stable order and one new node
+// per value, and (as with InsertSortedUp) put new values before equal
+// old ones when the list was sorted. Last, two million random values
+// are sorted, and the time taken printed.
+//
+// USAGE:
+//   a6sort
+// Prints the number of lists checked and "passed", or the first check
+// that failed and "FAILED"; the exit status is EXIT_SUCCESS only if it
+// passed.
+
+#include "llcpInt.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>  // provides exit, EXIT_SUCCESS, EXIT_FAILURE
+#include <iostream> // provides cout
+#include <random>
+#include <set>
+#include <vector>
+using namespace std;
+
+const int LISTS = 20000;
+const int MAX_LENGTH = 200;
+const int MAX_VALUES = 50;
+const int LONG_LIST = 2000000;
+
+mt19937 gen(1);
+int listNumber = 0;
+
+void fail(const char *what) {
+  cout << "list " << listNumber << ": " << what << endl
+       << "FAILED" << endl;
+  exit(EXIT_FAILURE);
+}
+
+bool LessData(const Node *a, const Node *b) { return a->data < b->data; }
+
+// Pre:  none
+// Post: the return value is the nodes of the list at headPtr, in order.
+vector<Node *> NodesOf(Node *headPtr) {
+  vector<Node *> nodes;
+  for (; headPtr != NULL; headPtr = headPtr->link)
+    nodes.push_back(headPtr);
+  return nodes;
+}
+
+// Pre:  length >= 0, range > 0
+// Post: the return value is a new list of length values below range
+//       (random, nearly sorted, sorted, reversed or all equal, by shape).
+Node *MakeShaped(int length, int range, int shape) {
+  Node *headPtr = NULL, **tailLink = &headPtr;
+  for (int i = 0; i < length; ++i) {
+    Node *newNodePtr = new Node;
+    switch (shape) {
+    case 0:
+      newNodePtr->data = gen() % range;
+      break;
+    case 1:
+      newNodePtr->data = i / 3 - (gen() % 8 == 0 ? int(gen() % 5) : 0);
+      break;
+    case 2:
+      newNodePtr->data = i / 2;
+      break;
+    case 3:
+      newNodePtr->data = length - i;
+      break;
+    default:
+      newNodePtr->data = range;
+      break;
+    }
+    newNodePtr->link = NULL;
+    *tailLink = newNodePtr;
+    tailLink = &newNodePtr->link;
+  }
+  return headPtr;
+}
+
+// Pre:  old holds the nodes of a list before MakeSorted added values to
+//       it (stably sorted by value), result its nodes after
+// Post: result has been checked to be non-decreasing, to hold the nodes
+//       of old in order and values.size() new ones holding values, and
+//       (if newFirst) to put new nodes before old ones of equal value;
+//       the program has stopped if it doesn't.
+void CheckMakeSorted(const vector<Node *> &old, const vector<int> &values,
+                     const vector<Node *> &result, bool newFirst) {
+  if (result.size() != old.size() + values.size())
+    fail("MakeSorted gave a list of the wrong length");
+  set<Node *> oldSet(old.begin(), old.end());
+  vector<Node *> kept;
+  vector<int> added;
+  for (size_t i = 0; i < result.size(); ++i) {
+    if (i > 0 && result[i - 1]->data > result[i]->data)
+      fail("MakeSorted gave an unsorted list");
+    if (oldSet.count(result[i]) != 0) {
+      kept.push_back(result[i]);
+    } else {
+      added.push_back(result[i]->data);
+      if (newFirst && i > 0 && oldSet.count(result[i - 1]) != 0 &&
+          result[i - 1]->data == result[i]->data)
+        fail("MakeSorted put a new value after an equal old one");
+    }
+  }
+  if (kept != old)
+    fail("MakeSorted lost or reordered the old nodes");
+  vector<int> sortedValues = values;
+  sort(sortedValues.begin(), sortedValues.end());
+  if (added != sortedValues)
+    fail("MakeSorted added the wrong values");
+}
+
+int main() {
+  for (listNumber = 0; listNumber < LISTS; ++listNumber) {
+    int length = gen() % 4 == 0 ? gen() % 3 : gen() % (MAX_LENGTH + 1);
+    int range = 1 + gen() % 50;
+    int shape = gen() % 5;
+
+    Node *headPtr = MakeShaped(length, range, shape);
+    vector<Node *> expected = NodesOf(headPtr);
+    stable_sort(expected.begin(), expected.end(), LessData);
+    SortNonDec(headPtr);
+    if (NodesOf(headPtr) != expected)
+      fail("SortNonDec sorted wrongly");
+
+    vector<int> values(gen() % (MAX_VALUES + 1));
+    for (size_t i = 0; i < values.size(); ++i)
+      values[i] = gen() % range;
+    const int *first = values.empty() ? NULL : &values[0];
+    MakeSorted(headPtr, first, int(values.size()));
+    CheckMakeSorted(expected, values, NodesOf(headPtr), true);
+    ListClear(headPtr, 1);
+
+    headPtr = MakeShaped(length, range, shape);
+    expected = NodesOf(headPtr);
+    stable_sort(expected.begin(), expected.end(), LessData);
+    MakeSorted(headPtr, first, int(values.size()));
+    CheckMakeSorted(expected, values, NodesOf(headPtr), false);
+    ListClear(headPtr, 1);
+  }
+  cout << LISTS << " lists sorted and added to: ok" << endl;
+
+  vector<int> values(LONG_LIST);
+  for (int i = 0; i < LONG_LIST; ++i)
+    values[i] = gen();
+  Node *headPtr = NULL;
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  MakeSorted(headPtr, &values[0], LONG_LIST);
+  double ms = chrono::duration<double, milli>(chrono::steady_clock::now() -
+                                              start).count();
+  if (FindListLength(headPtr) != LONG_LIST || !IsSortedUp(headPtr))
+    fail("sorting a long list went wrong");
+  ListClear(headPtr, 1);
+  cout << LONG_LIST << " random values sorted in " << ms << " ms: ok"
+       << endl;
+
+  cout << "passed" << endl;
+  return EXIT_SUCCESS;
+}
@@ -1,6 +1,8 @@
 #include "llcpInt.h"
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
+#include <vector>
 using namespace std;
 
 // definition of Merge2NonDecListsRecur
@@ -27,6 +29,117 @@ void Merge2NonDecListsRecur(Node *&headX, Node *&headY, Node *&headZ) {
   }
 }
 
+// Same relinking as Merge2NonDecListsRecur, with tailLink standing in
+// for the headZ (or headZ->link) that each recursive call would set.
+void Merge2NonDecListsIter(Node *&headX, Node *&headY, Node *&headZ) {
+  if (headX == NULL && headY == NULL)
+    return;
+  Node **tailLink = &headZ;
+
+  while (headX != NULL && headY != NULL) {
+    if (headX->data <= headY->data) {
+      *tailLink = headX;
+      headX = headX->link;
+    } else {
+      *tailLink = headY;
+      headY = headY->link;
+    }
+    tailLink = &(*tailLink)->link;
+  }
+  *tailLink = (headX != NULL) ? headX : headY;
+  headX = headY = NULL;
+}
+
+// A min-heap holds the index of each list not yet used up, ordered by
+// the value at its head (and by index between equal values, so that
+// the merge is stable). Each node costs O(log k) to place.
+void MergeKNonDecLists(Node *heads[], int k, Node *&headZ) {
+  struct Later {
+    Node **heads;
+    bool operator()(int a, int b) const {
+      return heads[a]->data > heads[b]->data ||
+             (heads[a]->data == heads[b]->data && a > b);
+    }
+  } later = {heads};
+  vector<int> heap;
+
+  for (int i = 0; i < k; ++i)
+    if (heads[i] != NULL)
+      heap.push_back(i);
+  if (heap.empty())
+    return;
+  make_heap(heap.begin(), heap.end(), later);
+
+  Node **tailLink = &headZ;
+  while (heap.size() > 1) {
+    pop_heap(heap.begin(), heap.end(), later);
+    int i = heap.back();
+    *tailLink = heads[i];
+    tailLink = &heads[i]->link;
+    heads[i] = heads[i]->link;
+    if (heads[i] != NULL)
+      push_heap(heap.begin(), heap.end(), later);
+    else
+      heap.pop_back();
+  }
+  // The last list left is taken whole.
+  *tailLink = heads[heap.front()];
+  heads[heap.front()] = NULL;
+}
+
+// Bottom-up: the list is cut into its runs of non-decreasing values (so
+// a sorted or nearly sorted list takes O(n)), and the runs are merged
+// like carries in a binary counter: runs[i] is NULL or a merge of 2^i
+// runs, and each new run is merged up through the occupied slots. The
+// older runs are always passed as headX, so equal values keep their
+// order.
+void SortNonDec(Node *&headPtr) {
+  Node *runs[64] = {NULL};
+  int top = 0;
+
+  while (headPtr != NULL) {
+    Node *run = headPtr, *last = headPtr;
+    while (last->link != NULL && last->data <= last->link->data)
+      last = last->link;
+    headPtr = last->link;
+    last->link = NULL;
+
+    int i = 0;
+    for (; runs[i] != NULL; ++i) {
+      Node *merged = NULL;
+      Merge2NonDecListsIter(runs[i], run, merged);
+      run = merged;
+    }
+    runs[i] = run;
+    if (i >= top)
+      top = i + 1;
+  }
+  for (int i = 0; i < top; ++i) {
+    Node *merged = NULL;
+    Merge2NonDecListsIter(runs[i], headPtr, merged);
+    headPtr = merged;
+  }
+}
+
+void MakeSorted(Node *&headPtr, const int values[], int count) {
+  Node *newHead = NULL, **tailLink = &newHead;
+
+  for (int i = 0; i < count; ++i) {
+    Node *newNodePtr = new Node;
+    newNodePtr->data = values[i];
+    newNodePtr->link = NULL;
+    *tailLink = newNodePtr;
+    tailLink = &newNodePtr->link;
+  }
+  SortNonDec(newHead);
+  // O(n) if headPtr is non-decreasing already (it is then one run).
+  SortNonDec(headPtr);
+  // New values go before equal old ones, as with InsertSortedUp.
+  Node *merged = NULL;
+  Merge2NonDecListsIter(newHead, headPtr, merged);
+  headPtr = merged;
+}
+
 int FindListLength(Node *headPtr) {
   int length = 0;
 
@@ -24,5 +24,22 @@ void   ListClear(Node*& headPtr, int noMsg = 0);
 // prototype of Merge2NonDecListsRecur
 void Merge2NonDecListsRecur(Node*& headX, Node*& headY, Node*& headZ);
 
+// iterative version of Merge2NonDecListsRecur (same result, but no
+// recursion, so lists of any length can be merged), and a k-way merge of
+// the non-decreasing lists heads[0] through heads[k-1] into headZ (all
+// of heads[] end up empty; equal values keep the order of their lists)
+void Merge2NonDecListsIter(Node*& headX, Node*& headY, Node*& headZ);
+void MergeKNonDecLists(Node* heads[], int k, Node*& headZ);
+
+// sorts the list into non-decreasing order by relinking its nodes (a
+// stable, non-recursive merge sort, O(n log n), allocating nothing)
+void SortNonDec(Node*& headPtr);
+// adds a node for each of values[0] through values[count-1] to the
+// list headPtr (in any order) and sorts the whole list into
+// non-decreasing order: O((n + count) log(n + count)), or only
+// O(n + count log count) if headPtr was already non-decreasing (then the
+// result is as from calls to InsertSortedUp)
+void MakeSorted(Node*& headPtr, const int values[], int count);
+
 
 #endif